@@ -0,0 +1,126 @@
+// Native micro-benchmark for base58::decode against the per-digit decoder it replaced.
+//
+//   cmake -S bench -B build-bench -DCMAKE_BUILD_TYPE=Release && cmake --build build-bench
+//   ./build-bench/base58_bench [iterations]
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base58.hpp"
+
+namespace legacy
+{
+
+const char base58_chars[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+bool map_initialized = false;
+std::array<int8_t, 256> base58_map{{0}};
+auto get_base58_map()
+{
+  if (!map_initialized)
+  {
+    for (unsigned i = 0; i < base58_map.size(); ++i)
+      base58_map[i] = -1;
+    for (unsigned i = 0; i < sizeof(base58_chars); ++i)
+      base58_map[base58_chars[i]] = i;
+    map_initialized = true;
+  }
+  return base58_map;
+}
+
+template <size_t size>
+bool base58_to_binary(std::string_view s, std::array<uint8_t, size> &result)
+{
+  result.fill(0);
+  for (auto &src_digit : s)
+  {
+    int carry = get_base58_map()[src_digit];
+    if (carry < 0)
+      return false;
+    for (auto &result_byte : result)
+    {
+      int x = result_byte * 58 + carry;
+      result_byte = x;
+      carry = x >> 8;
+    }
+    if (carry)
+      return false;
+  }
+  std::reverse(result.begin(), result.end());
+  return true;
+}
+
+} // namespace legacy
+
+template <size_t size>
+std::string encode(const std::array<uint8_t, size> &bytes)
+{
+  std::vector<uint8_t> value(bytes.begin(), bytes.end());
+  std::string out;
+  while (std::any_of(value.begin(), value.end(), [](uint8_t b) { return b != 0; }))
+  {
+    int remainder = 0;
+    for (auto &b : value)
+    {
+      int x = remainder * 256 + b;
+      b = x / 58;
+      remainder = x % 58;
+    }
+    out.push_back(base58::alphabet[remainder]);
+  }
+  for (size_t i = 0; i < bytes.size() && bytes[i] == 0; ++i)
+    out.push_back('1');
+  std::reverse(out.begin(), out.end());
+  return out;
+}
+
+template <typename Fn>
+double run(const char *label, const std::vector<std::string> &inputs, size_t iterations, Fn decode)
+{
+  std::array<uint8_t, 37> out;
+  uint64_t sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i)
+  {
+    const std::string &s = inputs[i % inputs.size()];
+    decode(s, out);
+    sink += out[i % out.size()];
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+  std::printf("%-16s %10.1f ns/key   (checksum %llu)\n", label, ns, (unsigned long long)sink);
+  return ns;
+}
+
+int main(int argc, char **argv)
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+  std::mt19937 rng(42);
+  std::vector<std::string> inputs;
+  for (int i = 0; i < 256; ++i)
+  {
+    std::array<uint8_t, 37> bytes;
+    for (auto &b : bytes)
+      b = rng();
+    std::string s = encode(bytes);
+
+    std::array<uint8_t, 37> a, b;
+    if (!legacy::base58_to_binary(s, a) || !base58::decode(s, b) || a != bytes || b != bytes)
+    {
+      std::fprintf(stderr, "decoders disagree on %s\n", s.c_str());
+      return 1;
+    }
+    inputs.push_back(s);
+  }
+
+  double before = run("legacy", inputs, iterations, [](const std::string &s, std::array<uint8_t, 37> &out) { legacy::base58_to_binary(s, out); });
+  double after = run("base58::decode", inputs, iterations, [](const std::string &s, std::array<uint8_t, 37> &out) { base58::decode(s, out); });
+  std::printf("speedup          %10.1fx\n", before / after);
+  return 0;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+// Minimal benchmark runner with the shape of Google Benchmark (State, range-for timing loop,
+// PauseTiming/ResumeTiming, Arg/Range parameters, BENCHMARK registration), so the suites read
+// the same way and can move to the real library if it is ever vendored.
+//
+//   ./orderbook_bench [filter]    runs every benchmark whose name contains filter
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <eosio/eosio.hpp>
+
+namespace benchmark {
+
+   class State {
+    public:
+      State(int64_t iterations, std::vector<int64_t> args) : _max_iterations(iterations), _args(std::move(args)) {}
+
+      int64_t range(size_t pos = 0) const { return _args.at(pos); }
+      int64_t iterations() const { return _max_iterations; }
+
+      void PauseTiming() { _elapsed += clock::now() - _start; }
+      void ResumeTiming() { _start = clock::now(); }
+
+      void SetLabel(const std::string &label) { _label = label; }
+
+      struct iterator {
+         State *state;
+         int64_t remaining;
+
+         bool operator!=(const iterator &) const {
+            if (remaining > 0)
+               return true;
+            state->finish();
+            return false;
+         }
+         iterator &operator++() {
+            --remaining;
+            return *this;
+         }
+         int operator*() const { return 0; }
+      };
+
+      iterator begin() {
+         _elapsed = clock::duration::zero();
+         ResumeTiming();
+         return iterator{this, _max_iterations};
+      }
+      iterator end() { return iterator{this, 0}; }
+
+      double elapsed_ns() const { return std::chrono::duration<double, std::nano>(_elapsed).count(); }
+      const std::string &label() const { return _label; }
+
+    private:
+      using clock = std::chrono::steady_clock;
+
+      void finish() { PauseTiming(); }
+
+      int64_t _max_iterations;
+      std::vector<int64_t> _args;
+      clock::time_point _start;
+      clock::duration _elapsed = clock::duration::zero();
+      std::string _label;
+   };
+
+   namespace internal {
+
+      struct Benchmark {
+         std::string name;
+         std::function<void(State &)> fn;
+         std::vector<int64_t> args;
+
+         Benchmark *Arg(int64_t a) {
+            args.push_back(a);
+            return this;
+         }
+
+         // powers of eight from lo to hi inclusive, as Google Benchmark does by default
+         Benchmark *Range(int64_t lo, int64_t hi) {
+            for (int64_t a = lo; a < hi; a *= 8)
+               args.push_back(a);
+            args.push_back(hi);
+            return this;
+         }
+      };
+
+      inline std::vector<Benchmark *> &registry() {
+         static std::vector<Benchmark *> benchmarks;
+         return benchmarks;
+      }
+
+      inline Benchmark *Register(const char *name, void (*fn)(State &)) {
+         registry().push_back(new Benchmark{name, fn, {}});
+         return registry().back();
+      }
+
+      // Each benchmark case starts from an empty chain state.
+      inline double run_once(Benchmark &b, std::vector<int64_t> args, int64_t iterations, std::string &label) {
+         eosio::native::reset_database();
+         eosio::native::reset_counters();
+         State state(iterations, std::move(args));
+         b.fn(state);
+         label = state.label();
+         return state.elapsed_ns();
+      }
+
+   } // namespace internal
+
+   inline int RunSpecifiedBenchmarks(int argc, char **argv) {
+      const char *filter = argc > 1 ? argv[1] : "";
+      constexpr double min_time_ns = 2e8;
+
+      std::printf("%-40s %15s %12s  %s\n", "Benchmark", "Time/iter", "Iterations", "");
+      for (auto *b : internal::registry()) {
+         std::vector<std::vector<int64_t>> cases;
+         if (b->args.empty())
+            cases.push_back({});
+         for (auto a : b->args)
+            cases.push_back({a});
+
+         for (auto &args : cases) {
+            std::string name = b->name;
+            for (auto a : args)
+               name += "/" + std::to_string(a);
+            if (std::strstr(name.c_str(), filter) == nullptr)
+               continue;
+
+            std::string label;
+            int64_t iterations = 1;
+            double ns = internal::run_once(*b, args, iterations, label);
+            while (ns < min_time_ns && iterations < 1000000000) {
+               double per_iter = std::max(ns / iterations, 1.0);
+               int64_t next = int64_t(min_time_ns * 1.4 / per_iter);
+               iterations = std::clamp<int64_t>(next, iterations * 2, iterations * 100);
+               ns = internal::run_once(*b, args, iterations, label);
+            }
+
+            std::printf("%-40s %12.0f ns %12lld  %s\n", name.c_str(), ns / iterations, (long long)iterations,
+                        label.c_str());
+         }
+      }
+      return 0;
+   }
+
+} // namespace benchmark
+
+#define BENCHMARK_CONCAT2(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT2(a, b)
+#define BENCHMARK(fn)                                                                                                  \
+   static ::benchmark::internal::Benchmark *BENCHMARK_CONCAT(_benchmark_, __LINE__) =                                  \
+       ::benchmark::internal::Register(#fn, fn)
+
+#define BENCHMARK_MAIN()                                                                                               \
+   int main(int argc, char **argv) { return ::benchmark::RunSpecifiedBenchmarks(argc, argv); }
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include "datastream.hpp"
+#include "name.hpp"
+#include "native.hpp"
+
+namespace eosio {
+
+   struct permission_level {
+      permission_level(name a, name p) : actor(a), permission(p) {}
+      permission_level() {}
+
+      friend constexpr bool operator==(const permission_level &a, const permission_level &b) {
+         return a.actor == b.actor && a.permission == b.permission;
+      }
+      friend constexpr bool operator<(const permission_level &a, const permission_level &b) {
+         return a.actor < b.actor || (a.actor == b.actor && a.permission < b.permission);
+      }
+
+      name actor;
+      name permission;
+   };
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const permission_level &v) { return ds << v.actor << v.permission; }
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, permission_level &v) { return ds >> v.actor >> v.permission; }
+
+   // Inline actions are not executed by the emulation; send() only counts them.
+   struct action {
+      eosio::name account;
+      eosio::name name;
+      std::vector<permission_level> authorization;
+      std::vector<char> data;
+
+      action() = default;
+
+      template <typename T>
+      action(const permission_level &auth, eosio::name a, eosio::name n, T &&value)
+          : account(a), name(n), authorization(1, auth), data(pack(std::forward<T>(value))) {}
+
+      template <typename T>
+      action(std::vector<permission_level> auths, eosio::name a, eosio::name n, T &&value)
+          : account(a), name(n), authorization(std::move(auths)), data(pack(std::forward<T>(value))) {}
+
+      void send() const {
+         native::state().inline_actions++;
+         native::state().inline_action_bytes += data.size();
+      }
+
+      void send_context_free() const { send(); }
+
+      template <typename T>
+      T data_as() { return unpack<T>(data); }
+   };
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const action &v) {
+      return ds << v.account << v.name << v.authorization << v.data;
+   }
+
+   inline void require_recipient(name) {}
+
+   template <typename... Accounts>
+   void require_recipient(name n, Accounts... accounts) {
+      require_recipient(n);
+      require_recipient(accounts...);
+   }
+
+   inline bool has_auth(name n) {
+      auto &s = native::state();
+      return s.authorize_all || s.authorized.count(n.value);
+   }
+
+   inline void require_auth(name n) { check(has_auth(n), "missing authority of " + n.to_string()); }
+   inline void require_auth(const permission_level &level) { require_auth(level.actor); }
+
+   inline bool is_account(name n) {
+      auto &s = native::state();
+      return s.all_accounts_exist || s.accounts.count(n.value);
+   }
+
+} // namespace eosio
+
+// the action payload is dropped; only the send is counted
+#define SEND_INLINE_ACTION(CONTRACT, NAME, ...)                                                    \
+   ::eosio::action(::eosio::permission_level{(CONTRACT).get_self(), ::eosio::name("active")},       \
+                   (CONTRACT).get_self(), ::eosio::name(#NAME), std::make_tuple())                  \
+       .send()
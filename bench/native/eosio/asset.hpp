@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stdint.h>
+#include <limits>
+#include <string>
+
+#include "check.hpp"
+#include "symbol.hpp"
+
+namespace eosio {
+
+   struct asset {
+      static constexpr int64_t max_amount = (1LL << 62) - 1;
+
+      int64_t amount = 0;
+      eosio::symbol symbol;
+
+      asset() {}
+      asset(int64_t a, class symbol s) : amount(a), symbol{s} {
+         check(is_amount_within_range(), "magnitude of asset amount must be less than 2^62");
+         check(symbol.is_valid(), "invalid symbol name");
+      }
+
+      bool is_amount_within_range() const { return -max_amount <= amount && amount <= max_amount; }
+      bool is_valid() const { return is_amount_within_range() && symbol.is_valid(); }
+
+      void set_amount(int64_t a) {
+         amount = a;
+         check(is_amount_within_range(), "magnitude of asset amount must be less than 2^62");
+      }
+
+      asset operator-() const {
+         asset r = *this;
+         r.amount = -r.amount;
+         return r;
+      }
+
+      asset &operator-=(const asset &a) {
+         check(a.symbol == symbol, "attempt to subtract asset with different symbol");
+         amount -= a.amount;
+         check(-max_amount <= amount, "subtraction underflow");
+         check(amount <= max_amount, "subtraction overflow");
+         return *this;
+      }
+
+      asset &operator+=(const asset &a) {
+         check(a.symbol == symbol, "attempt to add asset with different symbol");
+         amount += a.amount;
+         check(-max_amount <= amount, "addition underflow");
+         check(amount <= max_amount, "addition overflow");
+         return *this;
+      }
+
+      friend asset operator+(const asset &a, const asset &b) {
+         asset result = a;
+         result += b;
+         return result;
+      }
+
+      friend asset operator-(const asset &a, const asset &b) {
+         asset result = a;
+         result -= b;
+         return result;
+      }
+
+      asset &operator*=(int64_t a) {
+         __int128 tmp = (__int128)amount * (__int128)a;
+         check(tmp <= max_amount, "multiplication overflow");
+         check(tmp >= -max_amount, "multiplication underflow");
+         amount = (int64_t)tmp;
+         return *this;
+      }
+
+      friend asset operator*(const asset &a, int64_t b) {
+         asset result = a;
+         result *= b;
+         return result;
+      }
+
+      friend asset operator*(int64_t b, const asset &a) {
+         asset result = a;
+         result *= b;
+         return result;
+      }
+
+      asset &operator/=(int64_t a) {
+         check(a != 0, "divide by zero");
+         check(!(amount == std::numeric_limits<int64_t>::min() && a == -1), "signed division overflow");
+         amount /= a;
+         return *this;
+      }
+
+      friend asset operator/(const asset &a, int64_t b) {
+         asset result = a;
+         result /= b;
+         return result;
+      }
+
+      friend int64_t operator/(const asset &a, const asset &b) {
+         check(b.amount != 0, "divide by zero");
+         check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+         return a.amount / b.amount;
+      }
+
+      friend bool operator==(const asset &a, const asset &b) {
+         check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+         return a.amount == b.amount;
+      }
+
+      friend bool operator!=(const asset &a, const asset &b) { return !(a == b); }
+
+      friend bool operator<(const asset &a, const asset &b) {
+         check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+         return a.amount < b.amount;
+      }
+
+      friend bool operator<=(const asset &a, const asset &b) {
+         check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+         return a.amount <= b.amount;
+      }
+
+      friend bool operator>(const asset &a, const asset &b) {
+         check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+         return a.amount > b.amount;
+      }
+
+      friend bool operator>=(const asset &a, const asset &b) {
+         check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+         return a.amount >= b.amount;
+      }
+
+      std::string to_string() const {
+         int64_t p = (int64_t)symbol.precision();
+         int64_t p10 = 1;
+         for (int64_t i = 0; i < p; ++i)
+            p10 *= 10;
+         bool negative = amount < 0;
+         uint64_t abs_amount = negative ? -(uint64_t)amount : amount;
+         std::string result = std::to_string(abs_amount / p10);
+         if (p > 0) {
+            std::string fraction = std::to_string(abs_amount % p10);
+            result += "." + std::string(p - fraction.size(), '0') + fraction;
+         }
+         return (negative ? "-" : "") + result + " " + symbol.code().to_string();
+      }
+   };
+
+   struct extended_asset {
+      asset quantity;
+      name contract;
+   };
+
+} // namespace eosio
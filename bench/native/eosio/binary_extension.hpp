@@ -0,0 +1,55 @@
+#pragma once
+
+#include <utility>
+
+#include "check.hpp"
+
+namespace eosio {
+
+   template <typename T>
+   class binary_extension {
+    public:
+      using value_type = T;
+
+      constexpr binary_extension() {}
+      constexpr binary_extension(const T &ext) : _has_value(true), _data(ext) {}
+      constexpr binary_extension(T &&ext) : _has_value(true), _data(std::move(ext)) {}
+
+      constexpr bool has_value() const { return _has_value; }
+      constexpr explicit operator bool() const { return _has_value; }
+
+      T &value() & {
+         check(_has_value, "cannot get value of empty binary_extension");
+         return _data;
+      }
+      const T &value() const & {
+         check(_has_value, "cannot get value of empty binary_extension");
+         return _data;
+      }
+
+      T value_or() const { return _has_value ? _data : T{}; }
+      T value_or(const T &def) const { return _has_value ? _data : def; }
+
+      T &operator*() & { return value(); }
+      const T &operator*() const & { return value(); }
+      T *operator->() { return &value(); }
+      const T *operator->() const { return &value(); }
+
+      template <typename... Args>
+      binary_extension &emplace(Args &&...args) {
+         _data = T(std::forward<Args>(args)...);
+         _has_value = true;
+         return *this;
+      }
+
+      void reset() {
+         _data = T{};
+         _has_value = false;
+      }
+
+    private:
+      bool _has_value = false;
+      T _data{};
+   };
+
+} // namespace eosio
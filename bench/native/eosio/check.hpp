@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace eosio {
+
+   namespace native {
+      // thrown where the chain would abort the transaction
+      struct assert_exception : std::runtime_error {
+         using std::runtime_error::runtime_error;
+      };
+
+      [[noreturn]] inline void fail(std::string_view msg) { throw assert_exception(std::string(msg)); }
+   } // namespace native
+
+   inline void check(bool pred, const char *msg) {
+      if (!pred)
+         native::fail(msg);
+   }
+
+   inline void check(bool pred, const std::string &msg) {
+      if (!pred)
+         native::fail(msg);
+   }
+
+   inline void check(bool pred, std::string &&msg) {
+      if (!pred)
+         native::fail(msg);
+   }
+
+   inline void check(bool pred, uint64_t code) {
+      if (!pred)
+         native::fail("assertion failure with error code: " + std::to_string(code));
+   }
+
+   inline void eosio_assert(bool pred, const char *msg) { check(pred, msg); }
+
+} // namespace eosio
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+
+#include "check.hpp"
+#include "fixed_bytes.hpp"
+#include "varint.hpp"
+
+namespace eosio {
+
+   // Layout used by eosio.cdt 1.6: a key type tag plus 33 bytes of compressed key.
+   struct public_key {
+      unsigned_int type;
+      std::array<char, 33> data;
+
+      friend bool operator==(const public_key &a, const public_key &b) { return a.type == b.type && a.data == b.data; }
+      friend bool operator!=(const public_key &a, const public_key &b) { return !(a == b); }
+   };
+
+   struct signature {
+      unsigned_int type;
+      std::array<char, 65> data;
+   };
+
+   namespace native {
+
+      inline uint32_t rotr32(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+      inline uint32_t rotl32(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+      inline std::array<uint8_t, 32> sha256(const uint8_t *data, size_t len) {
+         static const uint32_t k[64] = {
+             0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+             0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+             0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+             0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+             0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+             0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+             0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+             0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+         uint32_t h[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+         std::vector<uint8_t> msg(data, data + len);
+         msg.push_back(0x80);
+         while (msg.size() % 64 != 56)
+            msg.push_back(0);
+         uint64_t bits = uint64_t(len) * 8;
+         for (int i = 7; i >= 0; --i)
+            msg.push_back(uint8_t(bits >> (i * 8)));
+
+         for (size_t off = 0; off < msg.size(); off += 64) {
+            uint32_t w[64];
+            for (int i = 0; i < 16; ++i)
+               w[i] = uint32_t(msg[off + 4 * i]) << 24 | uint32_t(msg[off + 4 * i + 1]) << 16 |
+                      uint32_t(msg[off + 4 * i + 2]) << 8 | uint32_t(msg[off + 4 * i + 3]);
+            for (int i = 16; i < 64; ++i) {
+               uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+               uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+               w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+            uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+            for (int i = 0; i < 64; ++i) {
+               uint32_t S1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+               uint32_t ch = (e & f) ^ (~e & g);
+               uint32_t t1 = hh + S1 + ch + k[i] + w[i];
+               uint32_t S0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+               uint32_t mj = (a & b) ^ (a & c) ^ (b & c);
+               uint32_t t2 = S0 + mj;
+               hh = g; g = f; f = e; e = d + t1; d = c; c = b; b = a; a = t1 + t2;
+            }
+            h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+         }
+
+         std::array<uint8_t, 32> out;
+         for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 4; ++j)
+               out[4 * i + j] = uint8_t(h[i] >> (24 - 8 * j));
+         return out;
+      }
+
+      inline std::array<uint8_t, 20> ripemd160(const uint8_t *data, size_t len) {
+         static const uint8_t r1[80] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                        7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+                                        3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+                                        1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+                                        4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13};
+         static const uint8_t r2[80] = {5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+                                        6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+                                        15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+                                        8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+                                        12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11};
+         static const uint8_t s1[80] = {11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+                                        7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+                                        11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+                                        11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+                                        9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6};
+         static const uint8_t s2[80] = {8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+                                        9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+                                        9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+                                        15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+                                        8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11};
+         static const uint32_t k1[5] = {0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e};
+         static const uint32_t k2[5] = {0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000};
+
+         auto f = [](int j, uint32_t x, uint32_t y, uint32_t z) -> uint32_t {
+            switch (j / 16) {
+            case 0: return x ^ y ^ z;
+            case 1: return (x & y) | (~x & z);
+            case 2: return (x | ~y) ^ z;
+            case 3: return (x & z) | (y & ~z);
+            default: return x ^ (y | ~z);
+            }
+         };
+
+         uint32_t h[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+         std::vector<uint8_t> msg(data, data + len);
+         msg.push_back(0x80);
+         while (msg.size() % 64 != 56)
+            msg.push_back(0);
+         uint64_t bits = uint64_t(len) * 8;
+         for (int i = 0; i < 8; ++i)
+            msg.push_back(uint8_t(bits >> (i * 8)));
+
+         for (size_t off = 0; off < msg.size(); off += 64) {
+            uint32_t x[16];
+            for (int i = 0; i < 16; ++i)
+               x[i] = uint32_t(msg[off + 4 * i]) | uint32_t(msg[off + 4 * i + 1]) << 8 |
+                      uint32_t(msg[off + 4 * i + 2]) << 16 | uint32_t(msg[off + 4 * i + 3]) << 24;
+
+            uint32_t al = h[0], bl = h[1], cl = h[2], dl = h[3], el = h[4];
+            uint32_t ar = h[0], br = h[1], cr = h[2], dr = h[3], er = h[4];
+            for (int j = 0; j < 80; ++j) {
+               uint32_t t = rotl32(al + f(j, bl, cl, dl) + x[r1[j]] + k1[j / 16], s1[j]) + el;
+               al = el; el = dl; dl = rotl32(cl, 10); cl = bl; bl = t;
+               t = rotl32(ar + f(79 - j, br, cr, dr) + x[r2[j]] + k2[j / 16], s2[j]) + er;
+               ar = er; er = dr; dr = rotl32(cr, 10); cr = br; br = t;
+            }
+            uint32_t t = h[1] + cl + dr;
+            h[1] = h[2] + dl + er;
+            h[2] = h[3] + el + ar;
+            h[3] = h[4] + al + br;
+            h[4] = h[0] + bl + cr;
+            h[0] = t;
+         }
+
+         std::array<uint8_t, 20> out;
+         for (int i = 0; i < 5; ++i)
+            for (int j = 0; j < 4; ++j)
+               out[4 * i + j] = uint8_t(h[i] >> (8 * j));
+         return out;
+      }
+
+   } // namespace native
+
+   inline checksum256 sha256(const char *data, uint32_t length) {
+      return checksum256(native::sha256(reinterpret_cast<const uint8_t *>(data), length));
+   }
+
+   inline checksum160 ripemd160(const char *data, uint32_t length) {
+      return checksum160(native::ripemd160(reinterpret_cast<const uint8_t *>(data), length));
+   }
+
+   inline void assert_sha256(const char *data, uint32_t length, const checksum256 &hash) {
+      check(sha256(data, length) == hash, "hash mismatch");
+   }
+
+} // namespace eosio
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "asset.hpp"
+#include "check.hpp"
+#include "fixed_bytes.hpp"
+#include "crypto.hpp"
+#include "name.hpp"
+#include "symbol.hpp"
+#include "time.hpp"
+#include "varint.hpp"
+
+namespace eosio {
+
+   template <typename T>
+   class datastream {
+    public:
+      datastream(T start, size_t s) : _start(start), _pos(start), _end(start + s) {}
+
+      inline void skip(size_t s) { _pos += s; }
+
+      inline bool read(char *d, size_t s) {
+         check(size_t(_end - _pos) >= s, "datastream attempted to read past the end");
+         std::memcpy(d, _pos, s);
+         _pos += s;
+         return true;
+      }
+
+      inline bool write(const char *d, size_t s) {
+         check(_end - _pos >= (int32_t)s, "datastream attempted to write past the end");
+         std::memcpy((void *)_pos, d, s);
+         _pos += s;
+         return true;
+      }
+
+      inline bool write(char d) { return write(&d, 1); }
+
+      T pos() const { return _pos; }
+      bool valid() const { return _pos <= _end && _pos >= _start; }
+      bool seekp(size_t p) { _pos = _start + p; return _pos <= _end; }
+      size_t tellp() const { return size_t(_pos - _start); }
+      size_t remaining() const { return _end - _pos; }
+
+    private:
+      T _start;
+      T _pos;
+      T _end;
+   };
+
+   // byte counting stream used by pack_size
+   template <>
+   class datastream<size_t> {
+    public:
+      datastream(size_t init_size = 0) : _size(init_size) {}
+      inline bool skip(size_t s) { _size += s; return true; }
+      inline bool write(const char *, size_t s) { _size += s; return true; }
+      inline bool write(char) { _size++; return true; }
+      inline bool valid() const { return true; }
+      inline bool seekp(size_t p) { _size = p; return true; }
+      inline size_t tellp() const { return _size; }
+      inline size_t remaining() const { return 0; }
+
+    private:
+      size_t _size;
+   };
+
+   template <typename Stream, typename T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>> * = nullptr>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const T &v) {
+      ds.write(reinterpret_cast<const char *>(&v), sizeof(T));
+      return ds;
+   }
+
+   template <typename Stream, typename T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>> * = nullptr>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, T &v) {
+      ds.read(reinterpret_cast<char *>(&v), sizeof(T));
+      return ds;
+   }
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const unsigned_int &v) {
+      uint64_t val = v.value;
+      do {
+         uint8_t b = uint8_t(val) & 0x7f;
+         val >>= 7;
+         b |= ((val > 0) << 7);
+         ds.write((char)b);
+      } while (val);
+      return ds;
+   }
+
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, unsigned_int &vi) {
+      uint64_t v = 0;
+      char b = 0;
+      uint8_t by = 0;
+      do {
+         ds.read(&b, 1);
+         v |= uint32_t(uint8_t(b) & 0x7f) << by;
+         by += 7;
+      } while (uint8_t(b) & 0x80);
+      vi.value = static_cast<uint32_t>(v);
+      return ds;
+   }
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const name &v) { return ds << v.value; }
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, name &v) { return ds >> v.value; }
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const symbol_code &v) { return ds << v.raw(); }
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, symbol_code &v) {
+      uint64_t raw;
+      ds >> raw;
+      v = symbol_code(raw);
+      return ds;
+   }
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const symbol &v) { return ds << v.raw(); }
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, symbol &v) {
+      uint64_t raw;
+      ds >> raw;
+      v = symbol(raw);
+      return ds;
+   }
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const asset &v) { return ds << v.amount << v.symbol; }
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, asset &v) { return ds >> v.amount >> v.symbol; }
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const time_point_sec &v) { return ds << v.utc_seconds; }
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, time_point_sec &v) { return ds >> v.utc_seconds; }
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const time_point &v) { return ds << v.elapsed._count; }
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, time_point &v) { return ds >> v.elapsed._count; }
+
+   template <typename Stream, size_t Size>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const fixed_bytes<Size> &v) {
+      ds.write(reinterpret_cast<const char *>(v.data()), Size);
+      return ds;
+   }
+   template <typename Stream, size_t Size>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, fixed_bytes<Size> &v) {
+      ds.read(reinterpret_cast<char *>(v.data()), Size);
+      return ds;
+   }
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const public_key &v) {
+      ds << v.type;
+      ds.write(v.data.data(), v.data.size());
+      return ds;
+   }
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, public_key &v) {
+      ds >> v.type;
+      ds.read(v.data.data(), v.data.size());
+      return ds;
+   }
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const std::string &v) {
+      ds << unsigned_int(v.size());
+      if (v.size())
+         ds.write(v.data(), v.size());
+      return ds;
+   }
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, std::string &v) {
+      unsigned_int s;
+      ds >> s;
+      v.resize(s.value);
+      if (s.value)
+         ds.read(v.data(), v.size());
+      return ds;
+   }
+
+   template <typename Stream, typename T, size_t N>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const std::array<T, N> &v) {
+      for (const auto &i : v)
+         ds << i;
+      return ds;
+   }
+   template <typename Stream, typename T, size_t N>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, std::array<T, N> &v) {
+      for (auto &i : v)
+         ds >> i;
+      return ds;
+   }
+
+   namespace native {
+      template <typename Stream, typename T>
+      void pack_or_skip(datastream<Stream> &ds, const T &v);
+      template <typename Stream, typename T>
+      void unpack_or_skip(datastream<Stream> &ds, T &v);
+   } // namespace native
+
+   template <typename Stream, typename T>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const std::vector<T> &v) {
+      ds << unsigned_int(v.size());
+      for (const auto &i : v)
+         native::pack_or_skip(ds, i);
+      return ds;
+   }
+   template <typename Stream, typename T>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, std::vector<T> &v) {
+      unsigned_int s;
+      ds >> s;
+      v.resize(s.value);
+      for (auto &i : v)
+         native::unpack_or_skip(ds, i);
+      return ds;
+   }
+
+   template <typename Stream, typename T>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const std::set<T> &v) {
+      ds << unsigned_int(v.size());
+      for (const auto &i : v)
+         ds << i;
+      return ds;
+   }
+
+   template <typename Stream, typename K, typename V>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const std::map<K, V> &v) {
+      ds << unsigned_int(v.size());
+      for (const auto &i : v)
+         ds << i.first << i.second;
+      return ds;
+   }
+
+   template <typename Stream, typename T>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const std::optional<T> &v) {
+      ds << bool(v.has_value());
+      if (v)
+         ds << *v;
+      return ds;
+   }
+
+   template <typename Stream, typename A, typename B>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const std::pair<A, B> &v) { return ds << v.first << v.second; }
+
+   // Types without a stream operator (e.g. ad-hoc structs placed in action data) are counted
+   // by their in-memory size; the emulation never decodes them.
+   namespace native {
+      template <typename Stream, typename T, typename = void>
+      struct can_pack : std::false_type {};
+      template <typename Stream, typename T>
+      struct can_pack<Stream, T, std::void_t<decltype(std::declval<datastream<Stream> &>() << std::declval<const T &>())>> : std::true_type {};
+
+      template <typename Stream, typename T, typename = void>
+      struct can_unpack : std::false_type {};
+      template <typename Stream, typename T>
+      struct can_unpack<Stream, T, std::void_t<decltype(std::declval<datastream<Stream> &>() >> std::declval<T &>())>> : std::true_type {};
+
+      template <typename Stream, typename T>
+      void pack_or_skip(datastream<Stream> &ds, const T &v) {
+         if constexpr (can_pack<Stream, T>::value)
+            ds << v;
+         else
+            ds.skip(sizeof(T));
+      }
+
+      template <typename Stream, typename T>
+      void unpack_or_skip(datastream<Stream> &ds, T &v) {
+         if constexpr (can_unpack<Stream, T>::value)
+            ds >> v;
+         else
+            ds.skip(sizeof(T));
+      }
+   } // namespace native
+
+   template <typename Stream, typename... Args>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const std::tuple<Args...> &v) {
+      std::apply([&](const auto &...a) { (native::pack_or_skip(ds, a), ...); }, v);
+      return ds;
+   }
+   template <typename Stream, typename... Args>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, std::tuple<Args...> &v) {
+      std::apply([&](auto &...a) { (native::unpack_or_skip(ds, a), ...); }, v);
+      return ds;
+   }
+
+   template <typename T>
+   size_t pack_size(const T &value) {
+      if constexpr (native::can_pack<size_t, T>::value) {
+         datastream<size_t> ps;
+         ps << value;
+         return ps.tellp();
+      } else {
+         return sizeof(T);
+      }
+   }
+
+   template <typename T>
+   std::vector<char> pack(const T &value) {
+      std::vector<char> result;
+      if constexpr (native::can_pack<char *, T>::value) {
+         result.resize(pack_size(value));
+         datastream<char *> ds(result.data(), result.size());
+         ds << value;
+      }
+      return result;
+   }
+
+   template <typename T>
+   T unpack(const char *buffer, size_t len) {
+      T result;
+      datastream<const char *> ds(buffer, len);
+      ds >> result;
+      return result;
+   }
+
+   template <typename T>
+   T unpack(const std::vector<char> &bytes) { return unpack<T>(bytes.data(), bytes.size()); }
+
+} // namespace eosio
@@ -0,0 +1,54 @@
+#pragma once
+
+// Native builds call actions as member functions, so apply() is compiled but never driven. The
+// dispatch macros still expand like eosio.cdt's: one case per listed action, each instantiating
+// execute_action. A listed action that is missing, listed twice, not void or has a parameter
+// that cannot be unpacked therefore fails the native build as it would fail eosio-cpp.
+
+#include <tuple>
+#include <type_traits>
+
+#include "datastream.hpp"
+#include "name.hpp"
+#include "system.hpp"
+
+namespace eosio {
+
+   template <typename T, typename... Args>
+   bool execute_action(name, name, void (T::*)(Args...)) {
+      // the action data is never read natively; unpacking an empty stream only type-checks
+      std::tuple<std::decay_t<Args>...> args;
+      datastream<const char *> ds(nullptr, 0);
+      if (ds.remaining() > 0)
+         ds >> args;
+      return false;
+   }
+
+} // namespace eosio
+
+// (a)(b)(c) is walked by two macros that alternate, so neither is expanded inside itself; the
+// last one left over is pasted with _END into a macro that expands to nothing.
+#define NATIVE_DISPATCH_CAT(a, b) NATIVE_DISPATCH_CAT_I(a, b)
+#define NATIVE_DISPATCH_CAT_I(a, b) a##b
+#define NATIVE_DISPATCH_CASE(elem)                                                                 \
+   case ::eosio::name(#elem).value:                                                                \
+      ::eosio::execute_action(::eosio::name(receiver), ::eosio::name(code), &native_dispatch_type::elem); \
+      break;
+#define NATIVE_DISPATCH_A(elem) NATIVE_DISPATCH_CASE(elem) NATIVE_DISPATCH_B
+#define NATIVE_DISPATCH_B(elem) NATIVE_DISPATCH_CASE(elem) NATIVE_DISPATCH_A
+#define NATIVE_DISPATCH_A_END
+#define NATIVE_DISPATCH_B_END
+
+#define EOSIO_DISPATCH_HELPER(TYPE, MEMBERS)                                                       \
+   using native_dispatch_type = TYPE;                                                              \
+   NATIVE_DISPATCH_CAT(NATIVE_DISPATCH_A MEMBERS, _END)
+
+#define EOSIO_DISPATCH(TYPE, MEMBERS)                                                              \
+   extern "C" {                                                                                    \
+   [[noreturn]] void apply(uint64_t receiver, uint64_t code, uint64_t action) {                    \
+      if (code == receiver) {                                                                      \
+         switch (action) { EOSIO_DISPATCH_HELPER(TYPE, MEMBERS) }                                  \
+      }                                                                                            \
+      ::eosio::eosio_exit(0);                                                                      \
+   }                                                                                               \
+   }
@@ -0,0 +1,31 @@
+#pragma once
+
+// Host-native stand-in for the eosio.cdt headers, used by the benchmarks under bench/. It keeps
+// the contract-facing API and semantics (check aborts with eosio::native::assert_exception,
+// tables behave like multi_index) but runs in-process so contract code can be profiled with
+// ordinary tools. Inline actions and deferred transactions are counted, not executed.
+
+typedef unsigned __int128 uint128_t;
+typedef __int128 int128_t;
+
+#include "action.hpp"
+#include "asset.hpp"
+#include "binary_extension.hpp"
+#include "check.hpp"
+#include "contract.hpp"
+#include "crypto.hpp"
+#include "datastream.hpp"
+#include "dispatcher.hpp"
+#include "fixed_bytes.hpp"
+#include "ignore.hpp"
+#include "multi_index.hpp"
+#include "name.hpp"
+#include "print.hpp"
+#include "symbol.hpp"
+#include "system.hpp"
+#include "time.hpp"
+#include "varint.hpp"
+
+#define CONTRACT class
+#define ACTION void
+#define TABLE struct
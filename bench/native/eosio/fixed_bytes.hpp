@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+
+namespace eosio {
+
+   // Byte-oriented stand-in for the CDT fixed_bytes; ordering and byte extraction match.
+   template <size_t Size>
+   class fixed_bytes {
+    public:
+      fixed_bytes() : bytes{} {}
+      fixed_bytes(const std::array<uint8_t, Size> &arr) : bytes(arr) {}
+
+      const uint8_t *data() const { return bytes.data(); }
+      uint8_t *data() { return bytes.data(); }
+      constexpr size_t size() const { return Size; }
+
+      std::array<uint8_t, Size> extract_as_byte_array() const { return bytes; }
+
+      friend bool operator==(const fixed_bytes &a, const fixed_bytes &b) { return a.bytes == b.bytes; }
+      friend bool operator!=(const fixed_bytes &a, const fixed_bytes &b) { return a.bytes != b.bytes; }
+      friend bool operator<(const fixed_bytes &a, const fixed_bytes &b) { return a.bytes < b.bytes; }
+      friend bool operator<=(const fixed_bytes &a, const fixed_bytes &b) { return a.bytes <= b.bytes; }
+      friend bool operator>(const fixed_bytes &a, const fixed_bytes &b) { return a.bytes > b.bytes; }
+      friend bool operator>=(const fixed_bytes &a, const fixed_bytes &b) { return a.bytes >= b.bytes; }
+
+      std::string to_string() const {
+         static const char *hex = "0123456789abcdef";
+         std::string s;
+         for (auto b : bytes) {
+            s.push_back(hex[b >> 4]);
+            s.push_back(hex[b & 0xf]);
+         }
+         return s;
+      }
+
+      std::array<uint8_t, Size> bytes;
+   };
+
+   using checksum160 = fixed_bytes<20>;
+   using checksum256 = fixed_bytes<32>;
+   using checksum512 = fixed_bytes<64>;
+
+} // namespace eosio
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace eosio {
+
+   // Marks action parameters that the action reads itself from get_datastream().
+   template <typename T>
+   struct ignore {};
+
+   template <typename T>
+   struct ignore_wrapper {
+      constexpr ignore_wrapper() {}
+      constexpr ignore_wrapper(T val) : value(val) {}
+      constexpr operator T() { return value; }
+      T value;
+   };
+
+   // an ignored parameter is left in the stream for the action to read
+   template <typename DataStream, typename T>
+   DataStream &operator>>(DataStream &ds, ignore<T> &) {
+      return ds;
+   }
+
+} // namespace eosio
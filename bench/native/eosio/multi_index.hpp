@@ -0,0 +1,450 @@
+#pragma once
+
+// In-memory multi_index. Rows live in the process-wide registry in native.hpp, keyed by
+// (code, scope, table, row type), so every multi_index opened on the same table shares them.
+// Secondary indexes are kept as ordered (key, primary key) sets, which gives the same
+// iteration order as the chain: by secondary key, then by primary key.
+//
+// Every lookup, iterator move and write is counted in native::state(), so tools can compare
+// the table work of an action across states.
+
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdint.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "check.hpp"
+#include "datastream.hpp"
+#include "fixed_bytes.hpp"
+#include "name.hpp"
+#include "native.hpp"
+
+namespace eosio {
+
+   constexpr static inline name same_payer{};
+
+   template <class Class, typename Type, Type (Class::*PtrToMemberFunction)() const>
+   struct const_mem_fun {
+      typedef typename std::remove_reference<Type>::type result_type;
+      result_type operator()(const Class &x) const { return (x.*PtrToMemberFunction)(); }
+   };
+
+   template <name::raw IndexName, typename Extractor>
+   struct indexed_by {
+      enum constants { index_name = static_cast<uint64_t>(IndexName) };
+      typedef Extractor secondary_extractor_type;
+   };
+
+   namespace native {
+
+      template <typename T, typename... Indices>
+      struct table_data : table_base {
+         using keys_type = std::tuple<typename Indices::secondary_extractor_type::result_type...>;
+
+         struct row {
+            std::unique_ptr<T> obj;
+            keys_type keys;
+         };
+
+         std::map<uint64_t, row> rows;
+         std::tuple<std::set<std::pair<typename Indices::secondary_extractor_type::result_type, uint64_t>>...> secondary;
+
+         // The chain keeps loaded rows in the multi_index, so repeated dereferences of the
+         // same row are one load; this approximates that cache with the last row read.
+         uint64_t last_read = 0;
+         bool has_last_read = false;
+
+         size_t row_count() const override { return rows.size(); }
+
+         const T &load(typename std::map<uint64_t, row>::const_iterator it) {
+            if (!has_last_read || last_read != it->first) {
+               state().rows_read++;
+               last_read = it->first;
+               has_last_read = true;
+            }
+            return *it->second.obj;
+         }
+
+         keys_type extract(const T &obj) const {
+            return keys_type{typename Indices::secondary_extractor_type()(obj)...};
+         }
+
+         template <size_t... I>
+         void insert_keys(uint64_t pk, const keys_type &keys, std::index_sequence<I...>) {
+            (std::get<I>(secondary).emplace(std::get<I>(keys), pk), ...);
+         }
+
+         template <size_t... I>
+         void erase_keys(uint64_t pk, const keys_type &keys, std::index_sequence<I...>) {
+            (std::get<I>(secondary).erase(std::make_pair(std::get<I>(keys), pk)), ...);
+         }
+
+         void insert_keys(uint64_t pk, const keys_type &keys) { insert_keys(pk, keys, std::index_sequence_for<Indices...>{}); }
+         void erase_keys(uint64_t pk, const keys_type &keys) { erase_keys(pk, keys, std::index_sequence_for<Indices...>{}); }
+      };
+
+      template <typename... Indices>
+      constexpr size_t index_position(uint64_t index_name) {
+         constexpr uint64_t names[] = {uint64_t(Indices::index_name)..., 0};
+         for (size_t i = 0; i < sizeof...(Indices); ++i)
+            if (names[i] == index_name)
+               return i;
+         return sizeof...(Indices);
+      }
+
+   } // namespace native
+
+   template <name::raw TableName, typename T, typename... Indices>
+   class multi_index {
+    public:
+      using data_type = native::table_data<T, Indices...>;
+
+      struct const_iterator : public std::iterator<std::bidirectional_iterator_tag, const T> {
+         const_iterator() {}
+
+         friend bool operator==(const const_iterator &a, const const_iterator &b) {
+            return a._data == b._data && a._at_end == b._at_end && (a._at_end || a._pk == b._pk);
+         }
+         friend bool operator!=(const const_iterator &a, const const_iterator &b) { return !(a == b); }
+
+         const T &operator*() const {
+            check(!_at_end, "cannot dereference end iterator");
+            auto it = _data->rows.find(_pk);
+            check(it != _data->rows.end(), "dereference of deleted object");
+            return _data->load(it);
+         }
+         const T *operator->() const { return &operator*(); }
+
+         const_iterator &operator++() {
+            check(!_at_end, "cannot increment end iterator");
+            native::state().index_steps++;
+            auto it = _data->rows.upper_bound(_pk);
+            if (it == _data->rows.end())
+               _at_end = true;
+            else
+               _pk = it->first;
+            return *this;
+         }
+         const_iterator operator++(int) {
+            const_iterator result(*this);
+            ++(*this);
+            return result;
+         }
+
+         const_iterator &operator--() {
+            native::state().index_steps++;
+            auto it = _at_end ? _data->rows.end() : _data->rows.lower_bound(_pk);
+            check(it != _data->rows.begin(), "cannot decrement iterator at beginning of table");
+            --it;
+            _pk = it->first;
+            _at_end = false;
+            return *this;
+         }
+         const_iterator operator--(int) {
+            const_iterator result(*this);
+            --(*this);
+            return result;
+         }
+
+       private:
+         friend class multi_index;
+         const_iterator(data_type *d, uint64_t pk, bool at_end) : _data(d), _pk(pk), _at_end(at_end) {}
+
+         data_type *_data = nullptr;
+         uint64_t _pk = 0;
+         bool _at_end = true;
+      };
+
+      typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+      template <size_t I>
+      class index {
+       public:
+         using index_type = std::tuple_element_t<I, std::tuple<Indices...>>;
+         using secondary_key_type = typename index_type::secondary_extractor_type::result_type;
+         using set_type = std::set<std::pair<secondary_key_type, uint64_t>>;
+
+         struct const_iterator : public std::iterator<std::bidirectional_iterator_tag, const T> {
+            const_iterator() {}
+
+            friend bool operator==(const const_iterator &a, const const_iterator &b) {
+               return a._data == b._data && a._at_end == b._at_end && (a._at_end || a._entry == b._entry);
+            }
+            friend bool operator!=(const const_iterator &a, const const_iterator &b) { return !(a == b); }
+
+            const T &operator*() const {
+               check(!_at_end, "cannot dereference end iterator");
+               auto it = _data->rows.find(_entry.second);
+               check(it != _data->rows.end(), "dereference of deleted object");
+               return _data->load(it);
+            }
+            const T *operator->() const { return &operator*(); }
+
+            const_iterator &operator++() {
+               check(!_at_end, "cannot increment end iterator");
+               native::state().index_steps++;
+               auto &set = std::get<I>(_data->secondary);
+               auto it = set.upper_bound(_entry);
+               if (it == set.end())
+                  _at_end = true;
+               else
+                  _entry = *it;
+               return *this;
+            }
+            const_iterator operator++(int) {
+               const_iterator result(*this);
+               ++(*this);
+               return result;
+            }
+
+            const_iterator &operator--() {
+               native::state().index_steps++;
+               auto &set = std::get<I>(_data->secondary);
+               auto it = _at_end ? set.end() : set.lower_bound(_entry);
+               check(it != set.begin(), "cannot decrement iterator at beginning of index");
+               --it;
+               _entry = *it;
+               _at_end = false;
+               return *this;
+            }
+            const_iterator operator--(int) {
+               const_iterator result(*this);
+               --(*this);
+               return result;
+            }
+
+          private:
+            friend class index;
+            const_iterator(data_type *d, typename set_type::const_iterator it)
+                : _data(d), _at_end(it == std::get<I>(d->secondary).end()) {
+               if (!_at_end)
+                  _entry = *it;
+            }
+
+            data_type *_data = nullptr;
+            std::pair<secondary_key_type, uint64_t> _entry{};
+            bool _at_end = true;
+         };
+
+         typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+         static constexpr uint64_t name() { return uint64_t(index_type::index_name); }
+
+         const_iterator cbegin() const {
+            native::state().index_steps++;
+            return const_iterator(_mi->_data, set().begin());
+         }
+         const_iterator begin() const { return cbegin(); }
+         const_iterator cend() const { return const_iterator(_mi->_data, set().end()); }
+         const_iterator end() const { return cend(); }
+         const_reverse_iterator crbegin() const { return std::make_reverse_iterator(cend()); }
+         const_reverse_iterator rbegin() const { return crbegin(); }
+         const_reverse_iterator crend() const { return std::make_reverse_iterator(cbegin()); }
+         const_reverse_iterator rend() const { return crend(); }
+
+         const_iterator lower_bound(const secondary_key_type &key) const {
+            native::state().index_steps++;
+            return const_iterator(_mi->_data, set().lower_bound(std::make_pair(key, uint64_t(0))));
+         }
+
+         const_iterator upper_bound(const secondary_key_type &key) const {
+            native::state().index_steps++;
+            return const_iterator(_mi->_data, set().upper_bound(std::make_pair(key, std::numeric_limits<uint64_t>::max())));
+         }
+
+         const_iterator find(const secondary_key_type &key) const {
+            native::state().index_steps++;
+            auto it = set().lower_bound(std::make_pair(key, uint64_t(0)));
+            if (it == set().end() || it->first != key)
+               return cend();
+            return const_iterator(_mi->_data, it);
+         }
+
+         const_iterator require_find(const secondary_key_type &key, const char *error_msg = "unable to find secondary key") const {
+            auto itr = find(key);
+            check(itr != cend(), error_msg);
+            return itr;
+         }
+
+         const T &get(const secondary_key_type &key, const char *error_msg = "unable to find secondary key") const {
+            return *require_find(key, error_msg);
+         }
+
+         const_iterator iterator_to(const T &obj) const {
+            auto &row = _mi->_data->rows.at(obj.primary_key());
+            return const_iterator(_mi->_data, set().find(std::make_pair(std::get<I>(row.keys), obj.primary_key())));
+         }
+
+         template <typename Lambda>
+         void modify(const_iterator itr, eosio::name payer, Lambda &&updater) {
+            _mi->modify(*itr, payer, std::forward<Lambda>(updater));
+         }
+
+         const_iterator erase(const_iterator itr) {
+            check(itr != cend(), "cannot pass end iterator to erase");
+            const T &obj = *itr;
+            ++itr;
+            _mi->erase(obj);
+            return itr;
+         }
+
+         eosio::name get_code() const { return _mi->get_code(); }
+         uint64_t get_scope() const { return _mi->get_scope(); }
+
+       private:
+         friend class multi_index;
+         index(const multi_index *mi) : _mi(const_cast<multi_index *>(mi)) {}
+
+         const set_type &set() const { return std::get<I>(_mi->_data->secondary); }
+
+         multi_index *_mi;
+      };
+
+      multi_index(name code, uint64_t scope)
+          : _code(code), _scope(scope), _data(&native::table_for<data_type>(code.value, scope, static_cast<uint64_t>(TableName))) {}
+
+      name get_code() const { return _code; }
+      uint64_t get_scope() const { return _scope; }
+
+      const_iterator cbegin() const {
+         native::state().index_steps++;
+         if (_data->rows.empty())
+            return cend();
+         return const_iterator(_data, _data->rows.begin()->first, false);
+      }
+      const_iterator begin() const { return cbegin(); }
+      const_iterator cend() const { return const_iterator(_data, 0, true); }
+      const_iterator end() const { return cend(); }
+      const_reverse_iterator crbegin() const { return std::make_reverse_iterator(cend()); }
+      const_reverse_iterator rbegin() const { return crbegin(); }
+      const_reverse_iterator crend() const { return std::make_reverse_iterator(cbegin()); }
+      const_reverse_iterator rend() const { return crend(); }
+
+      const_iterator lower_bound(uint64_t primary) const {
+         native::state().index_steps++;
+         auto it = _data->rows.lower_bound(primary);
+         return it == _data->rows.end() ? cend() : const_iterator(_data, it->first, false);
+      }
+
+      const_iterator upper_bound(uint64_t primary) const {
+         native::state().index_steps++;
+         auto it = _data->rows.upper_bound(primary);
+         return it == _data->rows.end() ? cend() : const_iterator(_data, it->first, false);
+      }
+
+      uint64_t available_primary_key() const {
+         if (_data->rows.empty())
+            return 0;
+         uint64_t next = _data->rows.rbegin()->first + 1;
+         check(next != 0 && next < std::numeric_limits<uint64_t>::max() - 1,
+               "next primary key in table is at autoincrement limit");
+         return next;
+      }
+
+      template <name::raw IndexName>
+      auto get_index() const {
+         constexpr size_t I = native::index_position<Indices...>(static_cast<uint64_t>(IndexName));
+         static_assert(I < sizeof...(Indices), "name provided is not the name of any secondary index within multi_index");
+         return index<I>(this);
+      }
+
+      const_iterator iterator_to(const T &obj) const { return const_iterator(_data, obj.primary_key(), false); }
+
+      template <typename Lambda>
+      const_iterator emplace(name payer, Lambda &&constructor) {
+         check(payer.value != 0, "must specify a valid account to pay for new record");
+
+         auto obj = std::make_unique<T>();
+         constructor(*obj);
+         uint64_t pk = obj->primary_key();
+         check(_data->rows.find(pk) == _data->rows.end(),
+               "could not insert object, most likely a uniqueness constraint was violated");
+
+         native::state().rows_written++;
+         native::state().row_bytes_written += pack_size(*obj);
+
+         auto keys = _data->extract(*obj);
+         _data->insert_keys(pk, keys);
+         _data->rows.emplace(pk, typename data_type::row{std::move(obj), std::move(keys)});
+         return const_iterator(_data, pk, false);
+      }
+
+      template <typename Lambda>
+      void modify(const_iterator itr, name payer, Lambda &&updater) {
+         check(itr != end(), "cannot pass end iterator to modify");
+         modify(*itr, payer, std::forward<Lambda>(updater));
+      }
+
+      template <typename Lambda>
+      void modify(const T &obj, name, Lambda &&updater) {
+         uint64_t pk = obj.primary_key();
+         auto it = _data->rows.find(pk);
+         check(it != _data->rows.end() && it->second.obj.get() == &obj,
+               "object passed to modify is not in multi_index");
+
+         T &mutable_obj = *it->second.obj;
+         updater(mutable_obj);
+         check(pk == mutable_obj.primary_key(), "updater cannot change primary key when modifying an object");
+         native::state().rows_written++;
+         native::state().row_bytes_written += pack_size(mutable_obj);
+
+         auto keys = _data->extract(mutable_obj);
+         if (keys != it->second.keys) {
+            _data->erase_keys(pk, it->second.keys);
+            _data->insert_keys(pk, keys);
+            it->second.keys = std::move(keys);
+         }
+      }
+
+      const T &get(uint64_t primary, const char *error_msg = "unable to find key") const {
+         auto result = find(primary);
+         check(result != cend(), error_msg);
+         return *result;
+      }
+
+      const_iterator find(uint64_t primary) const {
+         native::state().index_steps++;
+         auto it = _data->rows.find(primary);
+         return it == _data->rows.end() ? cend() : const_iterator(_data, primary, false);
+      }
+
+      const_iterator require_find(uint64_t primary, const char *error_msg = "unable to find key") const {
+         auto itr = find(primary);
+         check(itr != cend(), error_msg);
+         return itr;
+      }
+
+      const_iterator erase(const_iterator itr) {
+         check(itr != end(), "cannot pass end iterator to erase");
+         const T &obj = *itr;
+         ++itr;
+         erase(obj);
+         return itr;
+      }
+
+      void erase(const T &obj) {
+         uint64_t pk = obj.primary_key();
+         auto it = _data->rows.find(pk);
+         check(it != _data->rows.end() && it->second.obj.get() == &obj,
+               "object passed to erase is not in multi_index");
+         native::state().rows_written++;
+         _data->erase_keys(pk, it->second.keys);
+         _data->rows.erase(it);
+         _data->has_last_read = false;
+      }
+
+    private:
+      template <size_t>
+      friend class index;
+
+      name _code;
+      uint64_t _scope;
+      data_type *_data;
+   };
+
+} // namespace eosio
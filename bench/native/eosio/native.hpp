@@ -0,0 +1,102 @@
+#pragma once
+
+// Process-wide chain state for the host-native emulation. Benchmarks and simulators drive it
+// through the functions in eosio::native; contract code only sees the usual intrinsics.
+
+#include <map>
+#include <memory>
+#include <set>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+
+namespace eosio::native {
+
+   struct table_base {
+      virtual ~table_base() = default;
+      virtual size_t row_count() const = 0;
+   };
+
+   struct table_key {
+      uint64_t code;
+      uint64_t scope;
+      uint64_t table;
+      const std::type_info *type;
+
+      bool operator<(const table_key &o) const {
+         return std::tie(code, scope, table) < std::tie(o.code, o.scope, o.table) ||
+                (std::tie(code, scope, table) == std::tie(o.code, o.scope, o.table) && type->before(*o.type));
+      }
+   };
+
+   struct chain_state {
+      // microseconds since epoch; advanced explicitly by the driver
+      int64_t now_us = 1577836800ll * 1000000; // 2020-01-01
+
+      bool authorize_all = true;
+      std::set<uint64_t> authorized;
+
+      bool all_accounts_exist = true;
+      std::set<uint64_t> accounts;
+
+      bool echo_prints = false;
+      uint64_t print_bytes = 0;
+
+      uint64_t inline_actions = 0;
+      uint64_t deferred_transactions = 0;
+      uint64_t inline_action_bytes = 0;
+      uint64_t deferred_action_bytes = 0;
+
+      // Table work. index_steps counts lookups and iterator moves (one db intrinsic each),
+      // rows_read counts row loads, rows_written counts stores, updates and removes.
+      uint64_t index_steps = 0;
+      uint64_t rows_read = 0;
+      uint64_t rows_written = 0;
+      uint64_t row_bytes_written = 0;
+
+      std::map<table_key, std::unique_ptr<table_base>> tables;
+   };
+
+   inline chain_state &state() {
+      static chain_state s;
+      return s;
+   }
+
+   // Rows are stored per C++ row type: two differently declared structs for the same table do
+   // not see each other's rows.
+   template <typename Table>
+   Table &table_for(uint64_t code, uint64_t scope, uint64_t table) {
+      auto &slot = state().tables[table_key{code, scope, table, &typeid(Table)}];
+      if (!slot)
+         slot = std::make_unique<Table>();
+      return static_cast<Table &>(*slot);
+   }
+
+   inline void reset_database() { state().tables.clear(); }
+
+   inline void reset_counters() {
+      state().print_bytes = 0;
+      state().inline_actions = 0;
+      state().deferred_transactions = 0;
+      state().inline_action_bytes = 0;
+      state().deferred_action_bytes = 0;
+      state().index_steps = 0;
+      state().rows_read = 0;
+      state().rows_written = 0;
+      state().row_bytes_written = 0;
+   }
+
+   // rows held across every table and scope
+   inline size_t row_count() {
+      size_t rows = 0;
+      for (auto &[key, table] : state().tables)
+         rows += table->row_count();
+      return rows;
+   }
+
+   inline void set_time_sec(uint32_t sec) { state().now_us = int64_t(sec) * 1000000; }
+   inline void advance_sec(uint32_t sec) { state().now_us += int64_t(sec) * 1000000; }
+
+} // namespace eosio::native
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "native.hpp"
+
+namespace eosio {
+
+   namespace native {
+      inline void prints(std::string_view s) {
+         state().print_bytes += s.size();
+         if (state().echo_prints)
+            std::fwrite(s.data(), 1, s.size(), stdout);
+      }
+
+      template <typename T, typename = void>
+      struct has_to_string : std::false_type {};
+      template <typename T>
+      struct has_to_string<T, std::void_t<decltype(std::declval<const T &>().to_string())>> : std::true_type {};
+   } // namespace native
+
+   template <typename T>
+   void print_one(const T &v) {
+      using D = std::decay_t<T>;
+      if constexpr (std::is_same_v<D, bool>)
+         native::prints(v ? "true" : "false");
+      else if constexpr (std::is_same_v<D, char>)
+         native::prints(std::string_view(&v, 1));
+      else if constexpr (std::is_same_v<D, const char *> || std::is_same_v<D, char *>)
+         native::prints(v);
+      else if constexpr (std::is_array_v<T>)
+         native::prints(v);
+      else if constexpr (std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view>)
+         native::prints(v);
+      else if constexpr (std::is_same_v<D, unsigned __int128> || std::is_same_v<D, __int128>)
+         native::prints(std::to_string((uint64_t)(v >> 64)) + ":" + std::to_string((uint64_t)v));
+      else if constexpr (std::is_arithmetic_v<D>)
+         native::prints(std::to_string(v));
+      else if constexpr (std::is_enum_v<D>)
+         native::prints(std::to_string(static_cast<std::underlying_type_t<D>>(v)));
+      else if constexpr (native::has_to_string<D>::value)
+         native::prints(v.to_string());
+      else
+         static_assert(!sizeof(T *), "print: unsupported type");
+   }
+
+   template <typename... Args>
+   void print(Args &&...args) {
+      (print_one(args), ...);
+   }
+
+   template <typename... Args>
+   void print_f(const char *fmt, Args &&...args) {
+      native::prints(fmt);
+      (print_one(args), ...);
+   }
+
+   inline void printhex(const void *data, uint32_t len) {
+      static const char *hex = "0123456789abcdef";
+      std::string s;
+      auto p = static_cast<const uint8_t *>(data);
+      for (uint32_t i = 0; i < len; ++i) {
+         s.push_back(hex[p[i] >> 4]);
+         s.push_back(hex[p[i] & 0xf]);
+      }
+      native::prints(s);
+   }
+
+} // namespace eosio
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "action.hpp"
+#include "check.hpp"
+#include "name.hpp"
+#include "native.hpp"
+#include "time.hpp"
+
+namespace eosio {
+
+   inline time_point current_time_point() { return time_point(microseconds(native::state().now_us)); }
+
+   inline block_timestamp current_block_time() { return block_timestamp(current_time_point()); }
+
+   inline time_point_sec publication_time() { return time_point_sec(current_time_point()); }
+
+   [[noreturn]] inline void eosio_exit(int32_t) { throw native::assert_exception("eosio_exit"); }
+
+} // namespace eosio
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "action.hpp"
+#include "native.hpp"
+#include "system.hpp"
+#include "time.hpp"
+#include "varint.hpp"
+
+namespace eosio {
+
+   typedef std::tuple<uint16_t, std::vector<char>> extension;
+   typedef std::vector<extension> extensions_type;
+
+   class transaction_header {
+    public:
+      transaction_header(time_point_sec exp = time_point_sec(current_time_point()) + 60) : expiration(exp) {}
+
+      time_point_sec expiration;
+      uint16_t ref_block_num = 0;
+      uint32_t ref_block_prefix = 0;
+      unsigned_int max_net_usage_words = 0UL;
+      uint8_t max_cpu_usage_ms = 0UL;
+      unsigned_int delay_sec = 0UL;
+   };
+
+   template <typename Stream>
+   datastream<Stream> &operator<<(datastream<Stream> &ds, const transaction_header &v) {
+      return ds << v.expiration << v.ref_block_num << v.ref_block_prefix << v.max_net_usage_words << v.max_cpu_usage_ms << v.delay_sec;
+   }
+   template <typename Stream>
+   datastream<Stream> &operator>>(datastream<Stream> &ds, transaction_header &v) {
+      return ds >> v.expiration >> v.ref_block_num >> v.ref_block_prefix >> v.max_net_usage_words >> v.max_cpu_usage_ms >> v.delay_sec;
+   }
+
+   // Deferred transactions are counted, not scheduled.
+   class transaction : public transaction_header {
+    public:
+      transaction(time_point_sec exp = time_point_sec(current_time_point()) + 60) : transaction_header(exp) {}
+
+      void send(const unsigned __int128 &, name, bool = false) const {
+         native::state().deferred_transactions++;
+         for (const auto &a : actions)
+            native::state().deferred_action_bytes += a.data.size();
+      }
+
+      std::vector<action> context_free_actions;
+      std::vector<action> actions;
+      extensions_type transaction_extensions;
+   };
+
+   inline void send_deferred(const unsigned __int128 &, name, const char *, size_t size, bool = false) {
+      native::state().deferred_transactions++;
+      native::state().deferred_action_bytes += size;
+   }
+
+   inline int cancel_deferred(const unsigned __int128 &) { return 0; }
+
+   inline size_t transaction_size() { return 0; }
+   inline int tapos_block_num() { return 0; }
+   inline int tapos_block_prefix() { return 0; }
+   inline uint32_t expiration() { return current_time_point().sec_since_epoch() + 60; }
+
+} // namespace eosio
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace eosio {
+
+   struct unsigned_int {
+      unsigned_int(uint32_t v = 0) : value(v) {}
+      operator uint32_t() const { return value; }
+
+      friend bool operator==(const unsigned_int &i, const uint32_t &v) { return i.value == v; }
+      friend bool operator==(const unsigned_int &i, const unsigned_int &v) { return i.value == v.value; }
+      friend bool operator!=(const unsigned_int &i, const unsigned_int &v) { return i.value != v.value; }
+
+      uint32_t value;
+   };
+
+   struct signed_int {
+      signed_int(int32_t v = 0) : value(v) {}
+      operator int32_t() const { return value; }
+      int32_t value;
+   };
+
+} // namespace eosio
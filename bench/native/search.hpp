@@ -0,0 +1,297 @@
+#pragma once
+
+// Adversarial worst-case search over table states. A scenario seeds the emulated chain from a
+// vector of integer parameters and then runs one action; the search mutates the parameters to
+// maximize the action's estimated CPU, first under a growing cap on rows in the database and
+// then shrinking the first state that exceeds the budget down to a minimal one.
+//
+//   ./orderbook_worst [filter] [--budget-us=10000] [--max-rows=65536] [--iterations=200] [--seed=1]
+//
+// CPU is estimated from the work counters in native::state() (index steps, row loads, row
+// writes, inline actions, deferred sends, bytes serialized) with the per-operation weights in
+// cost_model. The weights are rough WASM figures; calibrate them against tests/actions.perf.js
+// when the absolute numbers matter.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <eosio/eosio.hpp>
+
+namespace search {
+
+   struct work {
+      uint64_t index_steps = 0;
+      uint64_t rows_read = 0;
+      uint64_t rows_written = 0;
+      uint64_t inline_actions = 0;
+      uint64_t deferred_transactions = 0;
+      uint64_t bytes = 0;
+      double   native_us = 0;
+
+      static work capture(double native_us) {
+         auto &s = eosio::native::state();
+         work w;
+         w.index_steps = s.index_steps;
+         w.rows_read = s.rows_read;
+         w.rows_written = s.rows_written;
+         w.inline_actions = s.inline_actions;
+         w.deferred_transactions = s.deferred_transactions;
+         w.bytes = s.inline_action_bytes + s.deferred_action_bytes + s.row_bytes_written + s.print_bytes;
+         w.native_us = native_us;
+         return w;
+      }
+   };
+
+   struct cost_model {
+      double action_us = 100;     // dispatch and argument deserialization
+      double index_step_us = 2;   // db_find / db_next / db_lowerbound
+      double row_read_us = 1;     // db_get and row deserialization
+      double row_write_us = 8;    // db_store / db_update / db_remove
+      double inline_us = 40;      // the receiving action, billed to the same transaction
+      double deferred_us = 60;    // send_deferred and scheduling
+      double byte_us = 0.01;      // serialization per byte
+
+      double estimate_us(const work &w) const {
+         return action_us + index_step_us * w.index_steps + row_read_us * w.rows_read + row_write_us * w.rows_written +
+                inline_us * w.inline_actions + deferred_us * w.deferred_transactions + byte_us * w.bytes;
+      }
+   };
+
+   struct param {
+      std::string name;
+      int64_t min;
+      int64_t max;
+   };
+
+   struct scenario {
+      std::string name;
+      std::vector<param> params;
+      std::function<void(const std::vector<int64_t> &)> seed;
+      std::function<void()> run;
+   };
+
+   struct options {
+      std::string filter;
+      double budget_us = 10000;
+      size_t max_rows = 65536;
+      int iterations = 200;
+      uint32_t seed = 1;
+   };
+
+   // one seeded state and the work of running the action on it
+   struct outcome {
+      std::vector<int64_t> genome;
+      bool valid = false;
+      size_t rows = 0;
+      work w;
+      double cost_us = 0;
+   };
+
+   namespace internal {
+
+      inline std::vector<scenario *> &registry() {
+         static std::vector<scenario *> scenarios;
+         return scenarios;
+      }
+
+      inline std::string describe(const scenario &sc, const std::vector<int64_t> &genome) {
+         std::string out;
+         for (size_t i = 0; i < genome.size(); ++i)
+            out += (i ? " " : "") + sc.params[i].name + "=" + std::to_string(genome[i]);
+         return out;
+      }
+
+      // States the contract rejects (while seeding or running) are not candidates: the
+      // transaction would fail on a check, not on CPU.
+      inline outcome evaluate(const scenario &sc, const std::vector<int64_t> &genome, const cost_model &model) {
+         outcome o;
+         o.genome = genome;
+         eosio::native::reset_database();
+         eosio::native::reset_counters();
+         try {
+            sc.seed(genome);
+            o.rows = eosio::native::row_count();
+            eosio::native::reset_counters();
+
+            auto start = std::chrono::steady_clock::now();
+            sc.run();
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            o.w = work::capture(std::chrono::duration<double, std::micro>(elapsed).count());
+            o.cost_us = model.estimate_us(o.w);
+            o.valid = true;
+         } catch (const eosio::native::assert_exception &) {
+         }
+         return o;
+      }
+
+      // log-uniform, so small and large values are tried equally often
+      inline int64_t random_value(const param &p, std::mt19937 &rng) {
+         double lo = std::log(double(std::max<int64_t>(p.min, 1)));
+         double hi = std::log(double(std::max<int64_t>(p.max, 1)));
+         int64_t v = int64_t(std::exp(std::uniform_real_distribution<double>(lo, hi)(rng)));
+         if (p.min == 0 && rng() % 4 == 0)
+            v = 0;
+         return std::clamp(v, p.min, p.max);
+      }
+
+      inline std::vector<int64_t> mutate(const scenario &sc, std::vector<int64_t> genome, std::mt19937 &rng) {
+         size_t i = rng() % genome.size();
+         const param &p = sc.params[i];
+         int64_t &v = genome[i];
+         switch (rng() % 6) {
+            case 0: v = v * 2 + 1; break;
+            case 1: v = v / 2; break;
+            case 2: v = v + 1; break;
+            case 3: v = v - 1; break;
+            case 4: v = v + int64_t(rng() % 16) - 8; break;
+            default: v = random_value(p, rng); break;
+         }
+         v = std::clamp(v, p.min, p.max);
+         return genome;
+      }
+
+      // Hill climbing with occasional random restarts; only states within max_rows compete.
+      inline outcome climb(const scenario &sc, outcome best, size_t max_rows, const options &opt,
+                           const cost_model &model, std::mt19937 &rng) {
+         outcome current = best;
+         for (int it = 0; it < opt.iterations; ++it) {
+            std::vector<int64_t> genome;
+            if (it % 50 == 49) {
+               for (const auto &p : sc.params)
+                  genome.push_back(random_value(p, rng));
+            } else {
+               genome = mutate(sc, current.genome, rng);
+            }
+
+            outcome candidate = evaluate(sc, genome, model);
+            if (!candidate.valid || candidate.rows > max_rows)
+               continue;
+            if (candidate.cost_us >= current.cost_us || it % 50 == 49)
+               current = candidate;
+            if (candidate.cost_us > best.cost_us)
+               best = candidate;
+         }
+         return best;
+      }
+
+      // Lowers each parameter as far as it goes while the state stays over budget. Lowering one
+      // parameter can add rows elsewhere (fewer buckets, more orders per bucket), so a candidate
+      // with more rows than the current state is not taken.
+      inline outcome shrink(const scenario &sc, outcome over, const options &opt, const cost_model &model) {
+         for (bool changed = true; changed;) {
+            changed = false;
+            for (size_t i = 0; i < over.genome.size(); ++i) {
+               int64_t lo = sc.params[i].min, hi = over.genome[i];
+               while (lo < hi) {
+                  int64_t mid = lo + (hi - lo) / 2;
+                  std::vector<int64_t> genome = over.genome;
+                  genome[i] = mid;
+                  outcome candidate = evaluate(sc, genome, model);
+                  if (candidate.valid && candidate.cost_us > opt.budget_us && candidate.rows <= over.rows) {
+                     hi = mid;
+                     over = candidate;
+                     changed = true;
+                  } else {
+                     lo = mid + 1;
+                  }
+               }
+            }
+         }
+         return over;
+      }
+
+      inline void print_row(const char *label, const scenario &sc, const outcome &o) {
+         std::printf("  %-10s rows %7zu  est %9.0f us  steps %7llu  reads %7llu  writes %6llu  inline %5llu  deferred %4llu  "
+                     "bytes %8llu  native %8.0f us  %s\n",
+                     label, o.rows, o.cost_us, (unsigned long long)o.w.index_steps, (unsigned long long)o.w.rows_read,
+                     (unsigned long long)o.w.rows_written, (unsigned long long)o.w.inline_actions,
+                     (unsigned long long)o.w.deferred_transactions, (unsigned long long)o.w.bytes, o.w.native_us,
+                     describe(sc, o.genome).c_str());
+      }
+
+      inline options parse(int argc, char **argv) {
+         options opt;
+         for (int i = 1; i < argc; ++i) {
+            const char *arg = argv[i];
+            if (std::strncmp(arg, "--budget-us=", 12) == 0)
+               opt.budget_us = std::atof(arg + 12);
+            else if (std::strncmp(arg, "--max-rows=", 11) == 0)
+               opt.max_rows = std::strtoull(arg + 11, nullptr, 10);
+            else if (std::strncmp(arg, "--iterations=", 13) == 0)
+               opt.iterations = std::atoi(arg + 13);
+            else if (std::strncmp(arg, "--seed=", 7) == 0)
+               opt.seed = std::strtoul(arg + 7, nullptr, 10);
+            else
+               opt.filter = arg;
+         }
+         return opt;
+      }
+
+   } // namespace internal
+
+   inline scenario *Register(std::string name, std::vector<param> params,
+                             std::function<void(const std::vector<int64_t> &)> seed, std::function<void()> run) {
+      internal::registry().push_back(new scenario{std::move(name), std::move(params), std::move(seed), std::move(run)});
+      return internal::registry().back();
+   }
+
+   // For each scenario, doubles the row cap from 16 until the worst state found exceeds the
+   // budget (or max_rows is reached), printing the worst state at each cap, then shrinks the
+   // first state over budget.
+   inline int RunSpecifiedSearches(int argc, char **argv) {
+      options opt = internal::parse(argc, argv);
+      cost_model model;
+      std::printf("budget %.0f us, max rows %zu, %d iterations per cap, seed %u\n", opt.budget_us, opt.max_rows,
+                  opt.iterations, opt.seed);
+
+      for (auto *sc : internal::registry()) {
+         if (sc->name.find(opt.filter) == std::string::npos)
+            continue;
+         std::printf("\n%s\n", sc->name.c_str());
+
+         std::mt19937 rng(opt.seed);
+         std::vector<int64_t> start;
+         for (const auto &p : sc->params)
+            start.push_back(p.min);
+         outcome best = internal::evaluate(*sc, start, model);
+         if (!best.valid) {
+            std::printf("  the smallest state is rejected by the contract; check the scenario seed\n");
+            continue;
+         }
+
+         bool over = best.cost_us > opt.budget_us;
+         for (size_t cap = 16; !over && cap / 2 < opt.max_rows; cap *= 2) {
+            size_t max_rows = std::min(cap, opt.max_rows);
+            best = internal::climb(*sc, best, max_rows, opt, model, rng);
+            internal::print_row(("<=" + std::to_string(max_rows)).c_str(), *sc, best);
+            over = best.cost_us > opt.budget_us;
+         }
+
+         if (!over) {
+            std::printf("  stays under budget up to %zu rows\n", opt.max_rows);
+            continue;
+         }
+         internal::print_row("minimal", *sc, internal::shrink(*sc, best, opt, model));
+      }
+      return 0;
+   }
+
+} // namespace search
+
+#define SEARCH_CONCAT2(a, b) a##b
+#define SEARCH_CONCAT(a, b) SEARCH_CONCAT2(a, b)
+#define SEARCH_SCENARIO(...)                                                                                           \
+   static ::search::scenario *SEARCH_CONCAT(_scenario_, __LINE__) = ::search::Register(__VA_ARGS__)
+
+#define SEARCH_MAIN()                                                                                                  \
+   int main(int argc, char **argv) { return ::search::RunSpecifiedSearches(argc, argv); }
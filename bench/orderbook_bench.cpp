@@ -0,0 +1,236 @@
+// Native benchmarks for gftorderbook matching and liquidity bucket building.
+//
+//   cmake -S bench -B build-bench -DCMAKE_BUILD_TYPE=Release && cmake --build build-bench
+//   ./build-bench/orderbook_bench [filter]
+//
+// The contract is compiled against the in-memory emulation in bench/native, so each case
+// seeds its tables directly and calls the contract member under test.
+
+#include <algorithm>
+#include <math.h>
+#include <string>
+
+#include <eosio/eosio.hpp>
+#include <eosio/singleton.hpp>
+#include <eosio/transaction.hpp>
+
+#include "benchmark.hpp"
+
+// match_order and the table types are private members
+#define private public
+#include "gftorderbook/gftorderbook.cpp"
+#undef private
+
+namespace
+{
+
+const name      BOOK        = "gftorderbook"_n;
+const name      GYFTIE      = "gyftietoken"_n;
+const name      EOS_TOKEN   = "eosio.token"_n;
+const symbol    GFT         = symbol{"GFT", 8};
+const symbol    EOS         = symbol{"EOS", 4};
+
+// deep enough that no run of fills can exhaust a balance or the book totals
+const int64_t   DEEP_FUNDS  = 1000000000000000000ll;
+
+// twelve-character names from an index, so any number of distinct accounts sort in order
+name trader (const uint64_t& index)
+{
+  static const char digits[] = "abcdefghijklmnopqrstuvwxyz";
+  string s (12, 'a');
+  uint64_t i = index;
+  for (int pos = 11; pos >= 1 && i > 0; --pos) {
+    s[pos] = digits[i % 26];
+    i /= 26;
+  }
+  return name{s};
+}
+
+gftorderbook make_book ()
+{
+  return gftorderbook (BOOK, BOOK, datastream<const char*> (nullptr, 0));
+}
+
+void seed_config ()
+{
+  gftorderbook::config_table config (BOOK, BOOK.value);
+  gftorderbook::Config c;
+  c.gyftiecontract = GYFTIE;
+  c.valid_counter_token_contract = EOS_TOKEN;
+  c.valid_counter_token_symbol = EOS;
+  c.paused = 0;
+  config.set (c, BOOK);
+
+  gftorderbook::state_table state (BOOK, BOOK.value);
+  gftorderbook::State s;
+  s.last_price = asset {10000, EOS};
+  s.sell_orderbook_size_gft = asset {DEEP_FUNDS, GFT};
+  s.buy_orderbook_size_gft = asset {DEEP_FUNDS, GFT};
+  s.buy_orderbook_size_eos = asset {DEEP_FUNDS, EOS};
+  s.sell_orderbook_size_eos = asset {DEEP_FUNDS, EOS};
+  s.last_bucket_build_time = 0;
+  s.last_payrewbucks_time = 0;
+  s.buy_order_count = 0;
+  s.sell_order_count = 0;
+  state.set (s, BOOK);
+
+  gftorderbook::senderid_table sid (BOOK, BOOK.value);
+  sid.set (gftorderbook::SenderID{0}, BOOK);
+}
+
+void fund (const name& account, const symbol& sym, const name& token_contract)
+{
+  gftorderbook::balance_table b_t (BOOK, account.value);
+  b_t.emplace (BOOK, [&](auto &b) {
+    b.funds = asset {DEEP_FUNDS, sym};
+    b.token_contract = token_contract;
+  });
+}
+
+uint64_t add_sell (const name& seller, const int64_t& price, const int64_t& gft, const uint32_t& created)
+{
+  gftorderbook::sellorder_table s_t (BOOK, BOOK.value);
+  uint64_t id = s_t.available_primary_key();
+  s_t.emplace (BOOK, [&](auto &s) {
+    s.order_id = id;
+    s.seller = seller;
+    s.price_per_gft = asset {price, EOS};
+    s.gft_amount = asset {gft, GFT};
+    s.order_value = asset {price * gft / 100000000, EOS};
+    s.created_date = created;
+  });
+  return id;
+}
+
+uint64_t add_buy (const name& buyer, const int64_t& price, const int64_t& gft, const uint32_t& created)
+{
+  gftorderbook::buyorder_table b_t (BOOK, BOOK.value);
+  uint64_t id = b_t.available_primary_key();
+  b_t.emplace (BOOK, [&](auto &b) {
+    b.order_id = id;
+    b.buyer = buyer;
+    b.price_per_gft = asset {price, EOS};
+    b.gft_amount = asset {gft, GFT};
+    b.order_value = asset {price * gft / 100000000, EOS};
+    b.created_date = created;
+  });
+  return id;
+}
+
+// Resting depth on both sides that never crosses: bids below 1.0000 EOS, asks above it.
+void seed_resting_book (const int64_t& depth)
+{
+  for (int64_t i = 0; i < depth; ++i) {
+    name maker = trader (i);
+    fund (maker, GFT, GYFTIE);
+    fund (maker, EOS, EOS_TOKEN);
+    add_buy (maker, 9000 - (i % 1000), 100000000, 1);
+    add_sell (maker, 11000 + (i % 1000), 100000000, 1);
+  }
+}
+
+void label_actions (benchmark::State& state)
+{
+  auto& chain = eosio::native::state();
+  state.SetLabel ("inline actions/iter=" + std::to_string (chain.inline_actions / std::max<int64_t> (state.iterations(), 1)));
+}
+
+} // namespace
+
+// One fill between a crossing bid and ask with range(0) resting orders on each side.
+static void BM_match_order (benchmark::State& state)
+{
+  gftorderbook book = make_book();
+  seed_config ();
+  seed_resting_book (state.range(0));
+
+  name taker_buyer = trader (state.range(0));
+  name taker_seller = trader (state.range(0) + 1);
+  fund (taker_buyer, EOS, EOS_TOKEN);
+  fund (taker_seller, GFT, GYFTIE);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    uint64_t sell_id = add_sell (taker_seller, 10000, 100000000, 1);
+    uint64_t buy_id = add_buy (taker_buyer, 10000, 100000000, 2);
+    state.ResumeTiming();
+
+    book.match_order (sell_id, buy_id);
+  }
+  label_actions (state);
+}
+BENCHMARK(BM_match_order)->Range(8, 8 << 10);
+
+// processbook draining range(0) crossing pairs, one fill per recursion, over 1k resting orders.
+static void BM_processbook (benchmark::State& state)
+{
+  gftorderbook book = make_book();
+  seed_config ();
+  seed_resting_book (1000);
+
+  name taker_buyer = trader (1000);
+  name taker_seller = trader (1001);
+  fund (taker_buyer, EOS, EOS_TOKEN);
+  fund (taker_seller, GFT, GYFTIE);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      add_sell (taker_seller, 10000, 100000000, 1);
+      add_buy (taker_buyer, 10000, 100000000, 2);
+    }
+    state.ResumeTiming();
+
+    book.processbook ();
+  }
+  label_actions (state);
+}
+BENCHMARK(BM_processbook)->Arg(1)->Arg(8)->Arg(64)->Arg(256);
+
+// Quoting a market buy for range(0) x 1.1000 EOS against 8k resting orders per side; the asks
+// start at 1.1000 EOS for one GFT, so the quote walks close to range(0) of them.
+static void BM_quote (benchmark::State& state)
+{
+  gftorderbook book = make_book();
+  seed_config ();
+  seed_resting_book (8 << 10);
+
+  asset eos_amount = asset {11000 * state.range(0), EOS};
+  uint32_t orders_touched = 0;
+  for (auto _ : state) {
+    orders_touched = book.get_quote (eos_amount).orders_touched;
+  }
+  state.SetLabel ("orders touched=" + std::to_string (orders_touched));
+}
+BENCHMARK(BM_quote)->Range(1, 1 << 10);
+
+// Rebuilding a liquidity bucket that holds range(0) bids from distinct buyers. The bucket is
+// not the last one, so the reward payout that follows the last bucket is not included.
+static void BM_buildbucket (benchmark::State& state)
+{
+  gftorderbook book = make_book();
+  seed_config ();
+
+  gftorderbook::orderbucket_table ob_t (BOOK, BOOK.value);
+  for (uint64_t id = 0; id < 2; ++id) {
+    ob_t.emplace (BOOK, [&](auto &ob) {
+      ob.bucket_id = id;
+      ob.prox_bucket_min_scaled = id * 500000;
+      ob.prox_bucket_max_scaled = (id + 1) * 500000;
+      ob.bucket_size = asset {0, GFT};
+      ob.reward_due = asset {0, GFT};
+    });
+  }
+
+  // bids between 0.5000 and 1.0000 EOS all land in bucket 0
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    add_buy (trader (i), 5001 + (i % 4999), 100000000, 1);
+  }
+
+  for (auto _ : state) {
+    book.buildbucket (0);
+  }
+}
+BENCHMARK(BM_buildbucket)->Range(8, 8 << 10);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,218 @@
+// Worst-case search for the data-dependent gftorderbook actions: processbook recursion,
+// buildbucket scans and the open balance walk behind withdraw.
+//
+//   cmake -S bench -B build-bench -DCMAKE_BUILD_TYPE=Release && cmake --build build-bench
+//   ./build-bench/orderbook_worst [filter] [--budget-us=10000] [--max-rows=65536]
+//
+// See native/search.hpp for the search and the CPU estimate.
+
+#include <algorithm>
+#include <math.h>
+#include <string>
+
+#include <eosio/eosio.hpp>
+#include <eosio/singleton.hpp>
+#include <eosio/transaction.hpp>
+
+#include "search.hpp"
+
+// match_order and the table types are private members
+#define private public
+#include "gftorderbook/gftorderbook.cpp"
+#undef private
+
+namespace
+{
+
+const name      BOOK        = "gftorderbook"_n;
+const name      GYFTIE      = "gyftietoken"_n;
+const name      EOS_TOKEN   = "eosio.token"_n;
+const symbol    GFT         = symbol{"GFT", 8};
+const symbol    EOS         = symbol{"EOS", 4};
+
+// deep enough that no run of fills can exhaust a balance or the book totals
+const int64_t   DEEP_FUNDS  = 1000000000000000000ll;
+
+// twelve-character names from an index, so any number of distinct accounts sort in order
+name trader (const uint64_t& index)
+{
+  static const char digits[] = "abcdefghijklmnopqrstuvwxyz";
+  string s (12, 'a');
+  uint64_t i = index;
+  for (int pos = 11; pos >= 1 && i > 0; --pos) {
+    s[pos] = digits[i % 26];
+    i /= 26;
+  }
+  return name{s};
+}
+
+gftorderbook make_book ()
+{
+  return gftorderbook (BOOK, BOOK, datastream<const char*> (nullptr, 0));
+}
+
+void seed_config ()
+{
+  gftorderbook::config_table config (BOOK, BOOK.value);
+  gftorderbook::Config c;
+  c.gyftiecontract = GYFTIE;
+  c.valid_counter_token_contract = EOS_TOKEN;
+  c.valid_counter_token_symbol = EOS;
+  c.paused = 0;
+  config.set (c, BOOK);
+
+  gftorderbook::state_table state (BOOK, BOOK.value);
+  gftorderbook::State s;
+  s.last_price = asset {10000, EOS};
+  s.sell_orderbook_size_gft = asset {DEEP_FUNDS, GFT};
+  s.buy_orderbook_size_gft = asset {DEEP_FUNDS, GFT};
+  s.buy_orderbook_size_eos = asset {DEEP_FUNDS, EOS};
+  s.sell_orderbook_size_eos = asset {DEEP_FUNDS, EOS};
+  s.last_bucket_build_time = 0;
+  s.last_payrewbucks_time = 0;
+  s.buy_order_count = 0;
+  s.sell_order_count = 0;
+  state.set (s, BOOK);
+
+  gftorderbook::senderid_table sid (BOOK, BOOK.value);
+  sid.set (gftorderbook::SenderID{0}, BOOK);
+}
+
+void fund (const name& account, const symbol& sym, const name& token_contract)
+{
+  gftorderbook::balance_table b_t (BOOK, account.value);
+  b_t.emplace (BOOK, [&](auto &b) {
+    b.funds = asset {DEEP_FUNDS, sym};
+    b.token_contract = token_contract;
+  });
+}
+
+uint64_t add_sell (const name& seller, const int64_t& price, const int64_t& gft, const uint32_t& created)
+{
+  gftorderbook::sellorder_table s_t (BOOK, BOOK.value);
+  uint64_t id = s_t.available_primary_key();
+  s_t.emplace (BOOK, [&](auto &s) {
+    s.order_id = id;
+    s.seller = seller;
+    s.price_per_gft = asset {price, EOS};
+    s.gft_amount = asset {gft, GFT};
+    s.order_value = asset {price * gft / 100000000, EOS};
+    s.created_date = created;
+  });
+  return id;
+}
+
+uint64_t add_buy (const name& buyer, const int64_t& price, const int64_t& gft, const uint32_t& created)
+{
+  gftorderbook::buyorder_table b_t (BOOK, BOOK.value);
+  uint64_t id = b_t.available_primary_key();
+  b_t.emplace (BOOK, [&](auto &b) {
+    b.order_id = id;
+    b.buyer = buyer;
+    b.price_per_gft = asset {price, EOS};
+    b.gft_amount = asset {gft, GFT};
+    b.order_value = asset {price * gft / 100000000, EOS};
+    b.created_date = created;
+  });
+  return id;
+}
+
+// Resting depth on both sides that never crosses: bids below 1.0000 EOS, asks above it.
+void seed_resting_book (const int64_t& depth)
+{
+  for (int64_t i = 0; i < depth; ++i) {
+    name maker = trader (i);
+    fund (maker, GFT, GYFTIE);
+    fund (maker, EOS, EOS_TOKEN);
+    add_buy (maker, 9000 - (i % 1000), 100000000, 1);
+    add_sell (maker, 11000 + (i % 1000), 100000000, 1);
+  }
+}
+
+} // namespace
+
+// processbook with crossing_buys one-GFT bids at 1.0000 EOS against asks that each fill
+// buys_per_sell of them, over resting_depth non-crossing orders per side. seller_maker picks
+// which settle path the fills take.
+SEARCH_SCENARIO("processbook",
+  {{"crossing_buys", 1, 4096}, {"buys_per_sell", 1, 64}, {"resting_depth", 0, 4096}, {"seller_maker", 0, 1}},
+  [](const std::vector<int64_t>& p) {
+    seed_config ();
+    seed_resting_book (p[2]);
+
+    name taker_buyer = trader (1000000);
+    name taker_seller = trader (1000001);
+    fund (taker_buyer, EOS, EOS_TOKEN);
+    fund (taker_seller, GFT, GYFTIE);
+
+    uint32_t sell_created = p[3] ? 1 : 3;
+    for (int64_t i = 0; i < p[0]; ++i) {
+      add_buy (taker_buyer, 10000, 100000000, 2);
+    }
+    for (int64_t i = 0; i < p[0]; i += p[1]) {
+      add_sell (taker_seller, 10000, std::min (p[1], p[0] - i) * 100000000, sell_created);
+    }
+  },
+  [] { make_book().processbook (); });
+
+// buildbucket over bucket_bids bids inside the bucket from distinct_buyers accounts, after
+// skipping bids_above bids priced over it and clearing stale_users old bucket users.
+SEARCH_SCENARIO("buildbucket",
+  {{"bucket_bids", 0, 8192}, {"bids_above", 0, 8192}, {"distinct_buyers", 1, 8192}, {"stale_users", 0, 8192}},
+  [](const std::vector<int64_t>& p) {
+    seed_config ();
+
+    gftorderbook::orderbucket_table ob_t (BOOK, BOOK.value);
+    for (uint64_t id = 0; id < 2; ++id) {
+      ob_t.emplace (BOOK, [&](auto &ob) {
+        ob.bucket_id = id;
+        ob.prox_bucket_min_scaled = id * 500000;
+        ob.prox_bucket_max_scaled = (id + 1) * 500000;
+        ob.bucket_size = asset {0, GFT};
+        ob.reward_due = asset {0, GFT};
+      });
+    }
+
+    // bucket 0 holds bids between 0.5000 and 1.0000 EOS
+    for (int64_t i = 0; i < p[0]; ++i) {
+      add_buy (trader (i % p[2]), 5001 + (i % 4999), 100000000, 1);
+    }
+    for (int64_t i = 0; i < p[1]; ++i) {
+      add_buy (trader (i), 10001 + i, 100000000, 1);
+    }
+
+    gftorderbook::bucketuser_table bu_t (BOOK, 0);
+    for (int64_t i = 0; i < p[3]; ++i) {
+      bu_t.emplace (BOOK, [&](auto &bu) {
+        bu.user = trader (1000000 + i);
+        bu.bucketuser_size = asset {100000000, GFT};
+      });
+    }
+  },
+  [] { make_book().buildbucket (0); });
+
+// withdraw for an account with own_sells asks and own_buys bids open, among other_orders
+// orders from other accounts on each side.
+SEARCH_SCENARIO("withdraw",
+  {{"own_sells", 0, 8192}, {"own_buys", 0, 8192}, {"other_orders", 0, 8192}},
+  [](const std::vector<int64_t>& p) {
+    seed_config ();
+
+    name account = trader (1000000);
+    fund (account, GFT, GYFTIE);
+    fund (account, EOS, EOS_TOKEN);
+
+    for (int64_t i = 0; i < p[0]; ++i) {
+      add_sell (account, 11000 + (i % 1000), 1, 1);
+    }
+    for (int64_t i = 0; i < p[1]; ++i) {
+      add_buy (account, 9000 - (i % 1000), 1, 1);
+    }
+    for (int64_t i = 0; i < p[2]; ++i) {
+      add_sell (trader (i), 11000 + (i % 1000), 100000000, 1);
+      add_buy (trader (i), 9000 - (i % 1000), 100000000, 1);
+    }
+  },
+  [] { make_book().withdraw (trader (1000000)); });
+
+SEARCH_MAIN();
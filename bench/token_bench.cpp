@@ -0,0 +1,151 @@
+// Native benchmarks for gyftietoken transfers, profile promotion and badge rewards.
+//
+//   cmake -S bench -B build-bench -DCMAKE_BUILD_TYPE=Release && cmake --build build-bench
+//   ./build-bench/token_bench [filter]
+//
+// The contract is compiled against the in-memory emulation in bench/native, so each case
+// seeds its tables directly and calls the contract member under test.
+
+#include <algorithm>
+#include <iterator>
+#include <math.h>
+#include <set>
+#include <string>
+
+#include <eosio/eosio.hpp>
+#include <eosio/singleton.hpp>
+#include <eosio/transaction.hpp>
+
+#include "benchmark.hpp"
+
+// the balance tables and helper classes are private members
+#define private public
+#include "gyftietoken/gyftietoken.cpp"
+#undef private
+
+namespace
+{
+
+const name      TOKEN       = "gyftietoken"_n;
+
+// twelve-character names from an index, so any number of distinct accounts sort in order
+name member (const uint64_t& index)
+{
+  static const char digits[] = "abcdefghijklmnopqrstuvwxyz";
+  string s (12, 'a');
+  uint64_t i = index;
+  for (int pos = 11; pos >= 1 && i > 0; --pos) {
+    s[pos] = digits[i % 26];
+    i /= 26;
+  }
+  return name{s};
+}
+
+gyftietoken make_token ()
+{
+  return gyftietoken (TOKEN, TOKEN, datastream<const char*> (nullptr, 0));
+}
+
+// count members with V2 profiles at the default rank, each holding balance GFT
+void seed_members (gyftietoken& token, const int64_t& count, const int64_t& balance)
+{
+  token.create ();
+
+  for (int64_t i = 0; i < count; ++i) {
+    name account = member (i);
+    token.profileClass.create (account);
+    if (balance > 0) {
+      gyftietoken::accounts acnts (TOKEN, account.value);
+      acnts.emplace (TOKEN, [&](auto &a) {
+        a.balance = asset {balance, common::S_GFT};
+      });
+      auto p_itr = token.profileClass.profile2_t.find (account.value);
+      token.profileClass.profile2_t.modify (p_itr, TOKEN, [&](auto &p) {
+        p.gft_balance = asset {balance, common::S_GFT};
+      });
+    }
+  }
+}
+
+} // namespace
+
+// One transfer between existing holders with range(0) profiles in the table.
+static void BM_transfer (benchmark::State& state)
+{
+  gyftietoken token = make_token();
+  seed_members (token, state.range(0), 100000000000000ll);
+
+  name from = member (0);
+  name to = member (state.range(0) - 1);
+  asset quantity = asset {1, common::S_GFT};
+
+  for (auto _ : state) {
+    token.transfer (from, to, quantity, "bench");
+    std::swap (from, to);
+  }
+}
+BENCHMARK(BM_transfer)->Range(8, 8 << 10);
+
+// Promoting an unranked profile voted for by 5 members of a rank shared by range(0) profiles.
+static void BM_promoteuser (benchmark::State& state)
+{
+  gyftietoken token = make_token();
+  seed_members (token, state.range(0), 0);
+
+  name candidate = member (state.range(0));
+  token.profileClass.create (candidate);
+  auto p_itr = token.profileClass.profile2_t.find (candidate.value);
+  token.profileClass.profile2_t.modify (p_itr, TOKEN, [&](auto &p) {
+    for (int64_t i = 0; i < std::min<int64_t> (5, state.range(0)); ++i) {
+      p.promotion_votes_for_this_profile.push_back (member (i));
+    }
+  });
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    token.profileClass.profile2_t.modify (p_itr, TOKEN, [&](auto &p) {
+      p.rank = 0;
+    });
+    state.ResumeTiming();
+
+    token.profileClass.promoteuser (candidate);
+  }
+}
+BENCHMARK(BM_promoteuser)->Range(8, 8 << 10);
+
+// Awarding a fresh badge to a member with range(0) other badge holdings in the table.
+static void BM_reward_badge (benchmark::State& state)
+{
+  gyftietoken token = make_token();
+  seed_members (token, 0, 0);
+
+  const int64_t badge_count = 16;
+  for (int64_t b = 0; b < badge_count; ++b) {
+    token.badgeClass.add_badge (member (b), "badge", "", asset {0, common::S_GFT}, "", "", "", TOKEN, 0);
+  }
+
+  // spread existing holdings over other members; the recipient already holds a few badges
+  name recipient = member (0);
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    token.badgeClass.reward_badge (member (i / badge_count + 1), member (i % badge_count), "");
+  }
+  for (int64_t b = 0; b < badge_count / 2; ++b) {
+    token.badgeClass.reward_badge (recipient, member (b), "");
+  }
+
+  auto byholder = token.badgeClass.badgeaccount_t.get_index<"byholder"_n>();
+  for (auto _ : state) {
+    token.badgeClass.reward_badge (recipient, member (badge_count - 1), "");
+
+    state.PauseTiming();
+    auto ba_itr = byholder.lower_bound (recipient.value);
+    while (ba_itr->badge_id != member (badge_count - 1)) {
+      ba_itr++;
+    }
+    byholder.erase (ba_itr);
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_reward_badge)->Range(8, 8 << 10);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,100 @@
+// Worst-case search for the data-dependent gyftietoken paths: promoteuser rank scans and the
+// gyft throttle window.
+//
+//   cmake -S bench -B build-bench -DCMAKE_BUILD_TYPE=Release && cmake --build build-bench
+//   ./build-bench/token_worst [filter] [--budget-us=10000] [--max-rows=65536]
+//
+// See native/search.hpp for the search and the CPU estimate.
+
+#include <algorithm>
+#include <iterator>
+#include <math.h>
+#include <set>
+#include <string>
+
+#include <eosio/eosio.hpp>
+#include <eosio/singleton.hpp>
+#include <eosio/transaction.hpp>
+
+#include "search.hpp"
+
+// the helper classes are private members
+#define private public
+#include "gyftietoken/gyftietoken.cpp"
+#undef private
+
+namespace
+{
+
+const name      TOKEN       = "gyftietoken"_n;
+
+// twelve-character names from an index, so any number of distinct accounts sort in order
+name member (const uint64_t& index)
+{
+  static const char digits[] = "abcdefghijklmnopqrstuvwxyz";
+  string s (12, 'a');
+  uint64_t i = index;
+  for (int pos = 11; pos >= 1 && i > 0; --pos) {
+    s[pos] = digits[i % 26];
+    i /= 26;
+  }
+  return name{s};
+}
+
+gyftietoken make_token ()
+{
+  return gyftietoken (TOKEN, TOKEN, datastream<const char*> (nullptr, 0));
+}
+
+} // namespace
+
+// promoteuser for an unranked candidate holding votes spread over voter_ranks ranks, each
+// rank shared by rank_population profiles.
+SEARCH_SCENARIO("promoteuser",
+  {{"rank_population", 1, 8192}, {"voter_ranks", 1, 64}, {"votes", 1, 256}},
+  [](const std::vector<int64_t>& p) {
+    gyftietoken token = make_token();
+    token.create ();
+
+    for (int64_t r = 0; r < p[1]; ++r) {
+      for (int64_t i = 0; i < p[0]; ++i) {
+        name account = member (r * p[0] + i);
+        token.profileClass.create (account);
+        auto p_itr = token.profileClass.profile2_t.find (account.value);
+        token.profileClass.profile2_t.modify (p_itr, TOKEN, [&](auto &prof) {
+          prof.rank = r + 1;
+        });
+      }
+    }
+
+    name candidate = member (1000000);
+    token.profileClass.create (candidate);
+    auto p_itr = token.profileClass.profile2_t.find (candidate.value);
+    token.profileClass.profile2_t.modify (p_itr, TOKEN, [&](auto &prof) {
+      for (int64_t v = 0; v < std::min (p[2], p[0] * p[1]); ++v) {
+        prof.promotion_votes_for_this_profile.push_back (member ((v % p[1]) * p[0] + (v / p[1]) % p[0]));
+      }
+    });
+  },
+  [] { make_token().profileClass.promoteuser (member (1000000)); });
+
+// throttle_check after hours_idle hours without gyfts, with window_total gyfts in the window.
+SEARCH_SCENARIO("throttle_check",
+  {{"hours_idle", 0, 72}, {"window_total", 0, 4096}},
+  [](const std::vector<int64_t>& p) {
+    gyftietoken token = make_token();
+    token.gyftieClass.change_throttle (1000000);
+    token.gyftieClass.setusercnt (2000000);
+
+    GyftClass::GyftWindow window;
+    uint32_t now_bucket = current_block_time().to_time_point().sec_since_epoch() / GyftClass::THROTTLE_BUCKET_SECONDS;
+    window.newest_bucket = now_bucket - p[0];
+    for (int64_t i = 0; i < p[1]; ++i) {
+      window.bucket_counts[i % GyftClass::THROTTLE_BUCKETS]++;
+    }
+    window.window_total = p[1];
+    token.gyftClass.gyftwindow_t.set (window, TOKEN);
+  },
+  [] { make_token().gyftClass.throttle_check (); });
+
+SEARCH_MAIN();
@@ -1,6 +1,16 @@
-eosio-cpp -I=include -R=resources src/gyftietoken/gyftietoken.cpp -o=gyftie/gyftietoken/gyftietoken.wasm
-eosio-cpp -I=include -R=resources src/gyftietoken/gyftietoken.cpp -abigen -o=gyftie/gyftietoken/gyftietoken.abi
-eosio-cpp -I=include -R=resources src/gftorderbook/gftorderbook.cpp -o=gyftie/gftorderbook/gftorderbook.wasm
-eosio-cpp -I=include -R=resources src/gftorderbook/gftorderbook.cpp -abigen -o=gyftie/gftorderbook/gftorderbook.abi
-eosio-cpp -I=include -R=resources src/gftmultisig/gftmultisig.cpp -o=gyftie/gftmultisig/gftmultisig.wasm
-eosio-cpp -I=include -R=resources src/gftmultisig/gftmultisig.cpp -abigen -o=gyftie/gftmultisig/gftmultisig.abi
\ No newline at end of file
+# GYFTIE_PERFSTATS=1 ./compile.sh builds with the per-action perfstats table (include/perfstats.hpp)
+FLAGS=""
+if [ -n "$GYFTIE_PERFSTATS" ]; then
+    FLAGS="-DGYFTIE_PERFSTATS"
+fi
+# GYFTIE_TRACE_LEVEL=3 ./compile.sh keeps the debug traces (include/trace.hpp); the default 0 strips them all
+if [ -n "$GYFTIE_TRACE_LEVEL" ]; then
+    FLAGS="$FLAGS -DGYFTIE_TRACE_LEVEL=$GYFTIE_TRACE_LEVEL"
+fi
+
+eosio-cpp -I=include -R=resources $FLAGS src/gyftietoken/gyftietoken.cpp -o=gyftie/gyftietoken/gyftietoken.wasm
+eosio-cpp -I=include -R=resources $FLAGS src/gyftietoken/gyftietoken.cpp -abigen -o=gyftie/gyftietoken/gyftietoken.abi
+eosio-cpp -I=include -R=resources $FLAGS src/gftorderbook/gftorderbook.cpp -o=gyftie/gftorderbook/gftorderbook.wasm
+eosio-cpp -I=include -R=resources $FLAGS src/gftorderbook/gftorderbook.cpp -abigen -o=gyftie/gftorderbook/gftorderbook.abi
+eosio-cpp -I=include -R=resources $FLAGS src/gftmultisig/gftmultisig.cpp -o=gyftie/gftmultisig/gftmultisig.wasm
+eosio-cpp -I=include -R=resources $FLAGS src/gftmultisig/gftmultisig.cpp -abigen -o=gyftie/gftmultisig/gftmultisig.abi
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <eosio/asset.hpp>
 
 #include "common.hpp"
+#include "perfstats.hpp"
 #include "profile.hpp"
 
 using std::string;
@@ -29,7 +30,7 @@ class BadgeClass
     {
         name        badge_id        ;
         string      badge_name      ;
-        string      description     =   0;
+        string      description     ;
         asset       reward          = asset { 0, common::S_GFT };
         string      profile_image   ;
         string      badge_image     ;
@@ -87,6 +88,7 @@ class BadgeClass
                     const name& issuer,
                     const uint8_t& badge_type) {
 
+        perf::stats::count (perf::ROWS_WRITTEN);
         badge_t.emplace (contract, [&](auto &b) {
             b.badge_id      = badge_id;
             b.badge_name    = badge_name;
@@ -111,6 +113,7 @@ class BadgeClass
             }
         
         auto p2_itr = profileClass.profile2_t.find (account.value);
+        perf::stats::count (perf::ROWS_READ);
         if (p2_itr != profileClass.profile2_t.end()) {
             if (!is_badgeholder ("govtidver"_n, account) &&
                 p2_itr->idhash.length() > 0) {
@@ -133,17 +136,20 @@ class BadgeClass
 
         auto b_itr = badge_t.find (badge_id.value);
         check (b_itr != badge_t.end(), "Badge ID does not exist.");
+        perf::stats::count (perf::ROWS_READ);
 
         check (has_auth (b_itr->issuer) || has_auth (contract), "Permission denied. Badge reward must be approved by badge creator.");
 
         auto byholder = badgeaccount_t.get_index<"byholder"_n>();
         auto ba_itr = byholder.lower_bound (badge_recipient.value);
-        while (ba_itr->badge_holder == badge_recipient && ba_itr != byholder.end()) {
-            check (ba_itr->badge_id != badge_id, "Recipient has already received this badge. Recipient: " + 
-                badge_recipient.to_string() + "; Badge ID: " + badge_id.to_string());
+        while (ba_itr != byholder.end() && ba_itr->badge_holder == badge_recipient) {
+            common::lazy_check (ba_itr->badge_id != badge_id,
+                "Recipient has already received this badge. Recipient: ", badge_recipient, "; Badge ID: ", badge_id);
             ba_itr++;
+            perf::stats::count (perf::INDEX_STEPS);
         }
 
+        perf::stats::count (perf::ROWS_WRITTEN);
         badgeaccount_t.emplace (contract, [&](auto &ba) {
             ba.badgeacct_id     = badgeaccount_t.available_primary_key();
             ba.badge_id         = badge_id;
@@ -153,6 +159,7 @@ class BadgeClass
         });
 
         if (b_itr->reward.amount > 0) {
+            perf::stats::count (perf::INLINE_ACTIONS);
             action (
                 permission_level{contract, "owner"_n},
                 contract, "issuetostake"_n,
@@ -171,6 +178,7 @@ class BadgeClass
                     } else {
                         referrer_reward = b_itr->reward;
                     }
+                    perf::stats::count (perf::INLINE_ACTIONS);
                     action (
                         permission_level{contract, "owner"_n},
                         contract, "issuetostake"_n,
@@ -185,11 +193,12 @@ class BadgeClass
 
         auto byholder = badgeaccount_t.get_index<"byholder"_n>();
         auto ba_itr = byholder.lower_bound (account.value);
-        while (ba_itr->badge_holder == account && ba_itr != byholder.end()) {
+        while (ba_itr != byholder.end() && ba_itr->badge_holder == account) {
             if (ba_itr->badge_id == badge_id) {
                 return true;
             }
             ba_itr++;
+            perf::stats::count (perf::INDEX_STEPS);
         }
         return false;
     }
@@ -200,25 +209,28 @@ class BadgeClass
         auto b_itr = badge_t.find (badge_id.value);
         check (b_itr != badge_t.end(), "Badge ID does not exist.");
 
-        check (has_auth (contract) || has_auth(b_itr->issuer), 
-            "Permission denied. Must have approval from contract or issuer: " + b_itr->issuer.to_string());
+        common::lazy_check (has_auth (contract) || has_auth(b_itr->issuer),
+            "Permission denied. Must have approval from contract or issuer: ", b_itr->issuer);
 
         auto byholder = badgeaccount_t.get_index<"byholder"_n>();
         auto ba_itr = byholder.lower_bound (badge_recipient.value);
-        while (ba_itr->badge_holder == badge_recipient && ba_itr != byholder.end()) {
+        while (ba_itr != byholder.end() && ba_itr->badge_holder == badge_recipient) {
             
             if (ba_itr->badge_id == badge_id) {
+                perf::stats::count (perf::ROWS_WRITTEN);
                 byholder.erase (ba_itr);
                 return;
             }
             ba_itr++;
+            perf::stats::count (perf::INDEX_STEPS);
         }
     }
 
     void remove_badges (const name& badge_holder) {
         auto byholder = badgeaccount_t.get_index<"byholder"_n>();
         auto ba_itr = byholder.lower_bound (badge_holder.value);
-        while (ba_itr->badge_holder == badge_holder && ba_itr != byholder.end()) {
+        while (ba_itr != byholder.end() && ba_itr->badge_holder == badge_holder) {
+            perf::stats::count (perf::ROWS_WRITTEN);
             ba_itr = byholder.erase (ba_itr);
         }
     }
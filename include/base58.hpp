@@ -0,0 +1,77 @@
+#ifndef BASE58_H
+#define BASE58_H
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+#include <string_view>
+
+// Header-only base58 decoding shared by the key parsing in permissions.hpp. It has no eosio
+// dependencies so it can also be compiled natively by the benchmarks in bench/.
+namespace base58
+{
+
+constexpr char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+constexpr std::array<int8_t, 256> make_digit_map()
+{
+  std::array<int8_t, 256> map{};
+  for (size_t i = 0; i < map.size(); ++i)
+    map[i] = -1;
+  for (size_t i = 0; i < sizeof(alphabet) - 1; ++i)
+    map[static_cast<uint8_t>(alphabet[i])] = i;
+  return map;
+}
+
+inline constexpr std::array<int8_t, 256> digit_map = make_digit_map();
+
+// 58^5 is the largest power of 58 that fits in 32 bits
+constexpr size_t digits_per_step = 5;
+
+// Decodes s into exactly `size` big-endian bytes. Digits are folded into the accumulator five
+// at a time over 32-bit limbs. Returns false on an invalid digit or if the value overflows.
+template <size_t size>
+bool decode(std::string_view s, std::array<uint8_t, size> &out)
+{
+  constexpr size_t limb_count = (size + 3) / 4;
+  std::array<uint32_t, limb_count> limbs{}; // little-endian
+
+  size_t pos = 0;
+  while (pos < s.size())
+  {
+    uint32_t chunk = 0;
+    uint32_t multiplier = 1;
+    for (size_t n = 0; n < digits_per_step && pos < s.size(); ++n, ++pos)
+    {
+      int8_t digit = digit_map[static_cast<uint8_t>(s[pos])];
+      if (digit < 0)
+        return false;
+      chunk = chunk * 58 + digit;
+      multiplier *= 58;
+    }
+
+    uint64_t carry = chunk;
+    for (auto &limb : limbs)
+    {
+      uint64_t x = uint64_t{limb} * multiplier + carry;
+      limb = static_cast<uint32_t>(x);
+      carry = x >> 32;
+    }
+    if (carry)
+      return false;
+  }
+
+  if constexpr (size % 4 != 0)
+  {
+    if (limbs[limb_count - 1] >> (8 * (size % 4)))
+      return false;
+  }
+
+  for (size_t b = 0; b < size; ++b)
+    out[size - 1 - b] = static_cast<uint8_t>(limbs[b / 4] >> (8 * (b % 4)));
+  return true;
+}
+
+} // namespace base58
+
+#endif
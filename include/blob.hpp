@@ -0,0 +1,126 @@
+#ifndef BLOB_H
+#define BLOB_H
+
+#include <eosio/eosio.hpp>
+#include <eosio/crypto.hpp>
+#include <eosio/singleton.hpp>
+
+#include "common.hpp"
+
+using std::string;
+using std::vector;
+using namespace eosio;
+
+class BlobClass {
+
+    public:
+
+        // BLOB_STORE keeps payloads in the blobs table; HASH_ONLY keeps just the hash in RAM and
+        // leaves the payload in the action data of the transaction that supplied it
+        static constexpr uint8_t    BLOB_STORE      = 0;
+        static constexpr uint8_t    HASH_ONLY       = 1;
+
+        struct [[ eosio::table, eosio::contract("gyftietoken") ]] Blob
+        {
+            uint64_t        blob_id;
+            checksum256     blob_hash;
+            vector<char>    data;
+            uint32_t        ref_count       = 0;
+
+            uint64_t        primary_key () const { return blob_id; }
+            checksum256     by_hash () const { return blob_hash; }
+        };
+
+        typedef eosio::multi_index<"blobs"_n, Blob,
+            indexed_by<"byhash"_n, const_mem_fun<Blob, checksum256, &Blob::by_hash>>
+        > blob_table;
+
+        struct [[ eosio::table, eosio::contract("gyftietoken") ]] BlobConfig
+        {
+            uint8_t         mode            = BLOB_STORE;
+        };
+
+        typedef singleton<"blobconfigs"_n, BlobConfig> blobconfig_table;
+        typedef eosio::multi_index<"blobconfigs"_n, BlobConfig> blobconfig_table_placeholder;
+
+        name                contract;
+        blob_table          blob_t;
+        blobconfig_table    blobconfig_t;
+
+        BlobClass (const name& contract) :
+            contract (contract),
+            blob_t (contract, contract.value),
+            blobconfig_t (contract, contract.value) {}
+
+        void set_mode (const uint8_t& mode) {
+            common::lazy_check (mode == BLOB_STORE || mode == HASH_ONLY, "Invalid blob storage mode: ", mode);
+
+            BlobConfig config = blobconfig_t.get_or_default (BlobConfig());
+            config.mode = mode;
+            blobconfig_t.set (config, contract);
+        }
+
+        // whether a put with always_store takes a reference on a blob row in the current mode;
+        // owners keep this next to the hash and pass it back to release
+        bool counts (const bool& always_store) {
+            return always_store || blobconfig_t.get_or_default (BlobConfig()).mode == BLOB_STORE;
+        }
+
+        checksum256 put (const string& text) {
+            return put (text.data(), text.size(), false);
+        }
+
+        // always_store is for payloads the contract must read back later, e.g. proposal transactions
+        checksum256 put (const char* data, const size_t& size, const bool& always_store) {
+            checksum256 hash = sha256 (data, size);
+
+            if (!counts (always_store)) {
+                return hash;
+            }
+
+            auto hash_index = blob_t.get_index<"byhash"_n>();
+            auto b_itr = hash_index.find (hash);
+            if (b_itr == hash_index.end()) {
+                blob_t.emplace (contract, [&](auto &b) {
+                    b.blob_id   = blob_t.available_primary_key();
+                    b.blob_hash = hash;
+                    b.data      = vector<char> (data, data + size);
+                    b.ref_count = 1;
+                });
+            } else {
+                hash_index.modify (b_itr, contract, [&](auto &b) {
+                    b.ref_count++;
+                });
+            }
+            return hash;
+        }
+
+        vector<char> get (const checksum256& hash) {
+            auto hash_index = blob_t.get_index<"byhash"_n>();
+            auto b_itr = hash_index.find (hash);
+            check (b_itr != hash_index.end(), "Blob not found for hash.");
+            return b_itr->data;
+        }
+
+        // A put in HASH_ONLY mode took no reference, even when another owner's put of the same
+        // payload left a row, so only counted references are given back.
+        void release (const checksum256& hash, const bool& counted) {
+            if (!counted) {
+                return;
+            }
+
+            auto hash_index = blob_t.get_index<"byhash"_n>();
+            auto b_itr = hash_index.find (hash);
+            check (b_itr != hash_index.end(), "Blob not found for hash.");
+
+            if (b_itr->ref_count <= 1) {
+                hash_index.erase (b_itr);
+            } else {
+                hash_index.modify (b_itr, contract, [&](auto &b) {
+                    b.ref_count--;
+                });
+            }
+        }
+};
+
+#endif
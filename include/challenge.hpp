@@ -5,6 +5,7 @@
 #include <eosio/eosio.hpp>
 #include <eosio/multi_index.hpp>
 #include <eosio/asset.hpp>
+#include <eosio/binary_extension.hpp>
 
 #include "common.hpp"
 
@@ -24,9 +25,10 @@ class ChallengeClass
     {
         name            challenged_account;
         name            challenger_account;
-        vector<string>  challenge_notes;
+        vector<string>  challenge_notes;    // legacy; new notes are written to the notes log
         asset           challenge_stake;
         uint32_t        challenged_time;
+        binary_extension<bool>  stake_counted;  // set once challenge_stake is in challstakes
         uint64_t        primary_key () const { return challenged_account.value; }
         uint64_t        by_challenger() const { return challenger_account.value; }
     };
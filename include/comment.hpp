@@ -4,6 +4,7 @@
 #include <eosio/eosio.hpp>
 
 #include "permit.hpp"
+#include "blob.hpp"
 
 using namespace eosio;
 using std::string;
@@ -12,6 +13,8 @@ class CommentClass {
 
     public:
 
+        static constexpr uint64_t   NO_PROPOSAL     = -1;
+
         struct [[eosio::table, eosio::contract("gyftietoken")]] Comment 
         {
             uint64_t        comment_id;
@@ -45,57 +48,150 @@ class CommentClass {
             indexed_by<"byupdated"_n, const_mem_fun<Comment, uint64_t, &Comment::by_updated>>
         > comment_table;
 
+        static uint128_t thread_key (const uint64_t& parent_comment_id, const time_point_sec& created_date) {
+            return (uint128_t{parent_comment_id} << 64) | created_date.sec_since_epoch();
+        }
+
+        // Proposal comments are scoped by proposal_id in comments2 and profile comments by profile
+        // in profcomments; the tables are separate because a proposal id and a profile name can
+        // have the same scope value. Each thread pages independently through bythread, with
+        // (parent_comment_id, created_date) as the cursor. Comments with the same key, i.e.
+        // replies posted in the same second, follow in comment_id order: the index orders equal
+        // keys by primary key, and comment_id is unique within a scope. A page that ends in such
+        // a run resumes at the same key and skips the ids it has already returned.
+        //
+        // The text itself is kept in the blob store (or only in the action data, in hash-only
+        // mode) under comment_hash; comment_counted records whether that put took a reference on
+        // the blob row.
+        struct [[eosio::table, eosio::contract("gyftietoken")]] Comment2
+        {
+            uint64_t        comment_id;
+            name            comment_type;
+            uint64_t        proposal_id;    // optional - foreign key
+            name            profile;        // optional - foreign key
+            name            commenter;
+            uint64_t        parent_comment_id;
+            checksum256     comment_hash;
+            bool            comment_counted     = false;
+
+            time_point_sec  created_date        = time_point_sec(current_time_point());
+            time_point_sec  updated_date        = time_point_sec(current_time_point());
+
+            uint64_t        primary_key () const { return comment_id; }
+            uint128_t       by_thread () const { return thread_key (parent_comment_id, created_date); }
+        };
+
+        typedef eosio::multi_index<"comments2"_n, Comment2,
+            indexed_by<"bythread"_n, const_mem_fun<Comment2, uint128_t, &Comment2::by_thread>>
+        > comment2_table;
+
+        typedef eosio::multi_index<"profcomments"_n, Comment2,
+            indexed_by<"bythread"_n, const_mem_fun<Comment2, uint128_t, &Comment2::by_thread>>
+        > profcomment_table;
+
         name            contract;
+        BlobClass       blobClass;
 
         CommentClass (const name& contract) :
-            contract (contract) {}
+            contract (contract),
+            blobClass (contract) {}
+
+        // calls f with the table holding the thread of a proposal, or of a profile
+        template <typename F>
+        void with_thread (const uint64_t& proposal_id, const name& profile, F f) {
+            if (proposal_id != NO_PROPOSAL) {
+                comment2_table c_t (contract, proposal_id);
+                f (c_t);
+            } else {
+                profcomment_table c_t (contract, profile.value);
+                f (c_t);
+            }
+        }
 
-        void add_comment (const name& commenter, 
-                            const name& comment_type, 
+        void add_comment (const name& commenter,
+                            const name& comment_type,
                             const uint64_t& proposal_id,    // -1 for no proposal
                             const name& profile,            // "noprofile"_n for no profile
-                            const uint64_t& parent_id, 
+                            const uint64_t& parent_id,
                             const string& comment_text) {
-            
+
             Permit::permit (contract, commenter, name{0}, common::AUTH_ACTIVITY);
 
-            comment_table c_t (contract, contract.value);
-            c_t.emplace (contract, [&](auto& c) {
-                c.comment_id        = c_t.available_primary_key();
-                c.comment_type      = comment_type;
-                c.proposal_id       = proposal_id;
-                c.profile           = profile;
-                c.commenter         = commenter;
-                c.parent_comment_id = parent_id;
-                c.comment_text      = comment_text;
+            // ids start above the legacy table's, so a comment id never names a row in both
+            comment_table legacy_t (contract, contract.value);
+            uint64_t first_id = legacy_t.available_primary_key();
+
+            with_thread (proposal_id, profile, [&](auto& c_t) {
+                c_t.emplace (contract, [&](auto& c) {
+                    c.comment_id        = std::max (c_t.available_primary_key(), first_id);
+                    c.comment_type      = comment_type;
+                    c.proposal_id       = proposal_id;
+                    c.profile           = profile;
+                    c.commenter         = commenter;
+                    c.parent_comment_id = parent_id;
+                    c.comment_counted   = blobClass.counts (false);
+                    c.comment_hash      = blobClass.put (comment_text);
+                });
             });
         }
 
-        void remove_comment (const uint64_t& comment_id) {
-            comment_table c_t (contract, contract.value);
-            auto c_itr = c_t.find (comment_id);
-            check (c_itr != c_t.end(), "Comment ID not found: " + std::to_string(comment_id));
-            
-            Permit::permit (contract, c_itr->commenter, name{0}, common::AUTH_ACTIVITY);
+        void remove_comment (const uint64_t& proposal_id, const name& profile, const uint64_t& comment_id) {
+            if (update_legacy (comment_id, "This comment has been deleted")) {
+                return;
+            }
 
-            c_t.modify (c_itr, contract, [&](auto &c) {
-                c.comment_text  =   "This comment has been deleted";
-                c.updated_date  = time_point_sec(current_time_point());
+            with_thread (proposal_id, profile, [&](auto& c_t) {
+                auto c_itr = c_t.find (comment_id);
+                common::lazy_check (c_itr != c_t.end(), "Comment ID not found: ", comment_id);
+
+                Permit::permit (contract, c_itr->commenter, name{0}, common::AUTH_ACTIVITY);
+
+                blobClass.release (c_itr->comment_hash, c_itr->comment_counted);
+                c_t.modify (c_itr, contract, [&](auto &c) {
+                    c.comment_counted   = blobClass.counts (false);
+                    c.comment_hash      = blobClass.put ("This comment has been deleted");
+                    c.updated_date      = time_point_sec(current_time_point());
+                });
             });
         }
 
-        void edit_comment (const uint64_t& comment_id, const string& comment_text) {
+        void edit_comment (const uint64_t& proposal_id, const name& profile, const uint64_t& comment_id, const string& comment_text) {
+            if (update_legacy (comment_id, comment_text)) {
+                return;
+            }
+
+            with_thread (proposal_id, profile, [&](auto& c_t) {
+                auto c_itr = c_t.find (comment_id);
+                common::lazy_check (c_itr != c_t.end(), "Comment ID not found: ", comment_id);
+
+                Permit::permit (contract, c_itr->commenter, name{0}, common::AUTH_ACTIVITY);
+
+                blobClass.release (c_itr->comment_hash, c_itr->comment_counted);
+                c_t.modify (c_itr, contract, [&](auto &c) {
+                    c.comment_counted   = blobClass.counts (false);
+                    c.comment_hash      = blobClass.put (comment_text);
+                    c.updated_date      = time_point_sec(current_time_point());
+                });
+            });
+        }
+
+        // Comments written before the threaded tables stay in the contract-scoped comments table
+        // and are changed there, keeping their text inline; returns false if comment_id is not one.
+        bool update_legacy (const uint64_t& comment_id, const string& comment_text) {
             comment_table c_t (contract, contract.value);
             auto c_itr = c_t.find (comment_id);
-            check (c_itr != c_t.end(), "Comment ID not found: " + std::to_string(comment_id));
-            
+            if (c_itr == c_t.end()) {
+                return false;
+            }
+
             Permit::permit (contract, c_itr->commenter, name{0}, common::AUTH_ACTIVITY);
 
             c_t.modify (c_itr, contract, [&](auto &c) {
-                c.comment_text  =   comment_text;
+                c.comment_text  = comment_text;
                 c.updated_date  = time_point_sec(current_time_point());
             });
+            return true;
         }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -42,6 +42,42 @@ namespace common {
     static const int    ORACLE_ACTIVITY             =   11;
     static const int    SELFORSIGNATORY_ACTIVITY    =   12;
     static const int    SELLGFT_ACTIVITY            =   13;
+
+    namespace internal {
+        inline void append (std::string& msg, const char* part) { msg += part; }
+        inline void append (std::string& msg, const std::string& part) { msg += part; }
+        inline void append (std::string& msg, const name& part) { msg += part.to_string(); }
+        inline void append (std::string& msg, const symbol_code& part) { msg += part.to_string(); }
+        inline void append (std::string& msg, const asset& part) { msg += part.to_string(); }
+
+        template <typename T>
+        std::enable_if_t<std::is_arithmetic_v<T>> append (std::string& msg, const T& part) {
+            msg += std::to_string (part);
+        }
+
+        // string literals are passed on as const char*, other parts by their own type
+        template <typename T>
+        using part_t = std::conditional_t<std::is_array_v<T>, const std::remove_extent_t<T>*, T>;
+
+        template <typename... Parts>
+        [[gnu::noinline]] void fail (const Parts&... parts) {
+            std::string msg;
+            (append (msg, parts), ...);
+            eosio::check (false, msg);
+        }
+    }
+
+    // eosio::check with the message given as parts instead of a concatenated string:
+    //   common::lazy_check (p_itr != p_t.end(), "Account ", account, " does not have a profile.");
+    // The parts (literals, strings, names, symbol codes, assets, numbers) are only formatted
+    // when the condition fails, so the success path does not build or allocate the message.
+    template <typename... Parts>
+    inline void lazy_check (const bool condition, const Parts&... parts) {
+        if (!condition) {
+            // literals of different lengths share one instantiation
+            internal::fail<internal::part_t<Parts>...> (parts...);
+        }
+    }
 }
 
 #endif
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <eosio/singleton.hpp>
 #include <string>
 
+#include "permissions.hpp"
+
 using std::string;
 using namespace eosio;
 
@@ -23,9 +25,11 @@ CONTRACT gftmultisig : public contract
 
     ACTION delproposal (const uint64_t proposal_id);
 
-    ACTION clrproposals ();
+    ACTION clrproposals (const uint32_t max_rows);
+
+    ACTION clnrequests (const uint32_t max_rows);
 
-    ACTION clnrequests ();
+    ACTION indexreqs (const uint32_t max_rows);
 
     ACTION addrequest (const name gyfter,
                         const name recipient,
@@ -41,21 +45,48 @@ CONTRACT gftmultisig : public contract
     const string STATUS_OPEN = "OPEN";
     const string STATUS_APPROVED = "APPROVED";
 
+    // requests older than this are dropped by clnrequests even if the account was never created
+    static constexpr uint32_t REQUEST_TTL_SEC = 60 * 60 * 24 * 30;
+
     TABLE gyftrequest
     {
       name        recipient;
       name        gyfter;
-      string      owner_public_key;
+      string      owner_public_key;     // checked by addrequest; kept as text so older rows still read
       string      active_public_key;
       uint32_t    requested_date;
       uint64_t    primary_key() const { return  recipient.value; }
       uint64_t    by_gyfter () const { return gyfter.value; }
+      // recipient breaks ties so the key can be used as a resume cursor
+      uint128_t   by_requested () const { return (uint128_t{requested_date} << 64) | recipient.value; }
     };
 
     typedef eosio::multi_index<"gyftrequests"_n, gyftrequest,
       indexed_by<"bygyfter"_n,
-        const_mem_fun<gyftrequest, uint64_t, &gyftrequest::by_gyfter>>
+        const_mem_fun<gyftrequest, uint64_t, &gyftrequest::by_gyfter>>,
+      indexed_by<"byrequested"_n,
+        const_mem_fun<gyftrequest, uint128_t, &gyftrequest::by_requested>>
     > gyftrequest_table;
+
+    // where the next clnrequests call picks up in byrequested order
+    TABLE cleancursor
+    {
+      uint128_t   request_cursor  = 0;
+    };
+
+    typedef singleton<"cleancursor"_n, cleancursor> cleancursor_table;
+    typedef eosio::multi_index<"cleancursor"_n, cleancursor> cleancursor_table_placeholder;
+
+    // byrequested only has entries for requests written since it was added; indexreqs rewrites
+    // the older rows from next_recipient and sets requests_indexed once it reaches the end
+    TABLE reqindex
+    {
+      name        next_recipient;
+      bool        requests_indexed  = false;
+    };
+
+    typedef singleton<"reqindex"_n, reqindex> reqindex_table;
+    typedef eosio::multi_index<"reqindex"_n, reqindex> reqindex_table_placeholder;
     
     TABLE proposal
     {
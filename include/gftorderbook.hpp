@@ -5,13 +5,15 @@
 #include <eosio/time.hpp>
 #include <eosio/system.hpp>
 #include <string>
-#include <algorithm>    // std::min
+#include <algorithm>    // std::min, std::any_of
 #include <eosio/singleton.hpp>
 #include <eosio/transaction.hpp> // include this for transactions
 
 #include <math.h>
 #include "profile.hpp"
 #include "permit.hpp"
+#include "perfstats.hpp"
+#include "trace.hpp"
 
 using std::string;
 using std::vector;
@@ -23,6 +25,49 @@ CONTRACT gftorderbook : public contract
 
   public:
 
+    // reported by the quote action: what a market order for the quantity would fill right now
+    struct Quote
+    {
+        asset       spent;              // EOS spent on a buy, GFT sold on a sell
+        asset       filled;             // GFT bought or EOS received, before the fee
+        asset       fee;                // maker reward withheld from filled
+        asset       average_price;      // EOS per GFT over all fills
+        asset       worst_price;        // price of the last order touched
+        uint32_t    orders_touched;
+        asset       unfilled;           // part of the quantity the book cannot absorb
+    };
+
+    // one fill in a tradesbatch report
+    struct Fill
+    {
+        name        buyer;
+        name        seller;
+        name        market_maker;
+        asset       gft_amount;
+        asset       price;
+        asset       maker_reward;
+    };
+
+    // one order in a placeorders batch; side is "buy" or "sell"
+    struct OrderSpec
+    {
+        name        side;
+        asset       price_per_gft;
+        asset       gft_amount;
+    };
+
+    // one order in an orderresults report: the new order and what it filled on placement
+    struct OrderResult
+    {
+        name        side;               // "buy" or "sell"
+        uint64_t    order_id;
+        asset       filled_gft;
+        asset       filled_eos;         // at the fill prices, before fees
+        asset       fee;                // taker fee withheld: GFT on a buy, EOS on a sell
+        asset       maker_reward;       // earned where the order was the maker: EOS on a buy, GFT on a sell
+        asset       remaining_gft;      // left resting on the book
+    };
+
    ACTION upperm ();
 
     ACTION setconfig (name gyftiecontract, 
@@ -75,20 +120,37 @@ CONTRACT gftorderbook : public contract
 
    ACTION limitsellgft (name seller, asset price_per_gft, asset gft_amount);
 
+   ACTION placeorders (name account, vector<OrderSpec> orders);
+
+   ACTION amendorder (name account, name side, uint64_t order_id,
+                      asset price_per_gft, asset gft_amount);
+
     ACTION stack (name account, asset gft_amount, asset eos_amount);
 
    ACTION marketbuy (name buyer, asset eos_amount);
 
    ACTION marketsell (name seller, asset gft_amount);
 
+   ACTION quote (asset quantity);
+
    ACTION stacksell (name seller, asset gft_amount);
 
    ACTION stackbuy (name buyer, asset eos_amount);
 
    ACTION processbook ();
 
+   // no longer sent; kept so the ABI still decodes fills reported before tradesbatch
    ACTION tradeexec (name buyer, name seller, name market_maker, asset gft_amount, asset price, asset maker_reward);
 
+   ACTION tradesbatch (vector<Fill> fills);
+
+   // sent inline by quote; the trace carries the quote to the client
+   ACTION quoteresult (asset quantity, Quote result);
+
+   // sent inline by the actions that place orders when any of them filled on placement, with
+   // what each order filled; orders that only rest on the book are read from the order tables
+   ACTION orderresults (name account, vector<OrderResult> results);
+
    ACTION withdraw (name account);
 
    ACTION delbuyorder (uint64_t buyorder_id);
@@ -116,6 +178,22 @@ CONTRACT gftorderbook : public contract
 
    ACTION reassign (name current, name newacct, asset quantity);
 
+#ifdef GYFTIE_PERFSTATS
+    // per-action work counters, see perfstats.hpp
+    TABLE perfstat
+    {
+        name        action;
+        uint64_t    calls           = 0;
+        uint64_t    rows_read       = 0;
+        uint64_t    rows_written    = 0;
+        uint64_t    index_steps     = 0;
+        uint64_t    inline_actions  = 0;
+        uint64_t    deferred_sends  = 0;
+        uint64_t    primary_key() const { return action.value; }
+    };
+    typedef eosio::multi_index<"perfstats"_n, perfstat> perfstat_table;
+#endif
+
   private:
     const string symbol_name = "EOS";
     const symbol network_symbol = symbol(symbol_name, 4);
@@ -125,6 +203,13 @@ CONTRACT gftorderbook : public contract
     const uint8_t   PAUSED = 1;
     const uint8_t   UNPAUSED = 0;
     const float     MAKER_REWARD = 0.0100000000;
+    const uint32_t  MAX_BATCH_ORDERS = 100;
+
+    // orders placed by this action, while match_order records their fills
+    vector<OrderResult> placed_orders;
+
+    // fills of the current matching pass, reported in one tradesbatch by send_trades
+    vector<Fill>    pass_fills;
 
     // TABLE Promo 
     // {
@@ -186,6 +271,28 @@ CONTRACT gftorderbook : public contract
    typedef singleton<"liqrewards"_n, Liqreward> liqreward_table;
    typedef eosio::multi_index<"liqrewards"_n, Liqreward> liqreward_table_placeholder;
 
+    // OHLCV candles, scoped by interval in seconds (60, 3600, 86400). Each scope is a ring of
+    // CANDLE_RING_SIZES rows; slot = (open_time / interval) % ring size, and a slot is reused
+    // once its open_time is a full ring behind. Sort by open_time to read in time order.
+    TABLE candle
+    {
+        uint64_t    slot;
+        uint32_t    open_time;
+        asset       open;
+        asset       high;
+        asset       low;
+        asset       close;
+        asset       volume_gft;
+        asset       volume_eos;
+        uint32_t    trade_count;
+        uint64_t    primary_key() const { return slot; }
+    };
+    typedef eosio::multi_index<"candles"_n, candle> candle_table;
+
+    static constexpr int      CANDLE_INTERVAL_COUNT = 3;
+    static constexpr uint32_t CANDLE_INTERVALS[] = { 60, 3600, 86400 };
+    static constexpr uint32_t CANDLE_RING_SIZES[] = { 1440, 720, 365 };     // one day, 30 days, a year
+
     TABLE rewarddue 
     {
         name        recipient;
@@ -352,6 +459,11 @@ CONTRACT gftorderbook : public contract
 
     uint64_t get_next_sender_id()
     {
+        // every deferred send takes a sender id
+        perf::stats::count (perf::DEFERRED_SENDS);
+        perf::stats::count (perf::ROWS_READ);
+        perf::stats::count (perf::ROWS_WRITTEN);
+
         senderid_table sid (get_self(), get_self().value);
         SenderID s = sid.get();
         uint64_t return_senderid = s.last_sender_id;
@@ -386,7 +498,8 @@ CONTRACT gftorderbook : public contract
         }
 
         ProfileClass profileClass = ProfileClass (c.gyftiecontract);
-        check (profileClass.existsInV2(account), "Cannot process order book. Account " + account.to_string() + " must upgrade profile to version 2.");
+        common::lazy_check (profileClass.existsInV2(account),
+            "Cannot process order book. Account ", account, " must upgrade profile to version 2.");
 
         // profile_table p_t (c.gyftiecontract, get_self().value);
         // auto p_itr = p_t.find (account.value);
@@ -409,6 +522,9 @@ CONTRACT gftorderbook : public contract
             eosio::check (it != bal_table.end(), "Sender does not have a balance within the contract." );
             eosio::check (it->funds >= token_amount, "Insufficient balance.");
 
+            perf::stats::count (perf::ROWS_READ);
+            perf::stats::count (perf::ROWS_WRITTEN);
+
             bool remove_record = false;
             bal_table.modify (it, get_self(), [&](auto &b) {
                 if (b.funds == token_amount) {
@@ -422,6 +538,7 @@ CONTRACT gftorderbook : public contract
             paytoken (token_contract, get_self(), to, token_amount, memo);     
                 
             if (remove_record) {
+                perf::stats::count (perf::ROWS_WRITTEN);
                 bal_table.erase (it);
             }
         }  
@@ -433,20 +550,16 @@ CONTRACT gftorderbook : public contract
                     const asset token_amount,
                     const string memo)
     {
-        print("---------- Payment -----------\n");
-        print("Token Contract   : ", name{token_contract}, "\n");
-        print("From             : ", name{from}, "\n");
-        print("To               : ", name{to}, "\n");
-        print("Amount           : ", token_amount, "\n");
-        print("Memo             : ", memo, "\n");
+        perf::stats::count (perf::INLINE_ACTIONS);
+
+        TRACE_DEBUG ("payment", "contract", token_contract, "from", from, "to", to,
+                     "amount", token_amount, "memo", memo);
 
         action(
             permission_level{from, "owner"_n},
             token_contract, "transfer"_n,
             std::make_tuple(from, to, token_amount, memo))
             .send();
-
-        print("---------- End Payment -------\n");
     }
 
     void payrewbucks_deferred () 
@@ -514,6 +627,8 @@ CONTRACT gftorderbook : public contract
                     total_orders += s_itr->gft_amount;
                 }
                 s_itr++;
+                perf::stats::count (perf::INDEX_STEPS);
+                perf::stats::count (perf::ROWS_READ);
             }
         } else if (sym == c.valid_counter_token_symbol) {
             buyorder_table b_t (get_self(), get_self().value);
@@ -524,6 +639,8 @@ CONTRACT gftorderbook : public contract
                     total_orders += b_itr->order_value;
                 }
                 b_itr++;
+                perf::stats::count (perf::INDEX_STEPS);
+                perf::stats::count (perf::ROWS_READ);
             }            
         }
         return total_orders;
@@ -677,6 +794,21 @@ CONTRACT gftorderbook : public contract
         state.set (s, get_self());
     }
 
+    // both sides in one state write, for actions that add orders on both
+    void increase_liquidity (asset buy_gft_added, asset buy_eos_added, uint16_t buy_order_count_change,
+                             asset sell_gft_added, asset sell_eos_added, uint16_t sell_order_count_change)
+    {
+        state_table state (get_self(), get_self().value);
+        State s = state.get();
+        s.buy_orderbook_size_gft += buy_gft_added;
+        s.buy_orderbook_size_eos += buy_eos_added;
+        s.buy_order_count += buy_order_count_change;
+        s.sell_orderbook_size_gft += sell_gft_added;
+        s.sell_orderbook_size_eos += sell_eos_added;
+        s.sell_order_count += sell_order_count_change;
+        state.set (s, get_self());
+    }
+
     void increase_buygft_liquidity (asset new_gft_added, asset eos_added, uint16_t buy_order_count_change)
     {
         state_table state (get_self(), get_self().value);
@@ -687,44 +819,175 @@ CONTRACT gftorderbook : public contract
         state.set (s, get_self());
     }
 
-    void add_limitbuy_order (name buyer, asset price_per_gft, asset gft_amount)
+    // check_balance is false only when the order is paid from a deposit credited in the same action
+    uint64_t add_limitbuy_order (name buyer, asset price_per_gft, asset gft_amount, bool check_balance = true)
     {
         eosio::check (price_per_gft.amount > 0, "Price must be greater than zero.");
         eosio::check (gft_amount.amount > 0, "GFT amount must be greater than zero.");
 
-        confirm_balance (buyer, get_eos_order_value(price_per_gft, gft_amount));
+        if (check_balance) {
+            confirm_balance (buyer, get_eos_order_value(price_per_gft, gft_amount));
+        }
         increase_buygft_liquidity (gft_amount, get_eos_order_value(price_per_gft, gft_amount), 1);
 
+        return emplace_buy_order (buyer, price_per_gft, gft_amount);
+    }
+
+    // inserts the order row only; the caller has checked the balance and updated the liquidity
+    uint64_t emplace_buy_order (name buyer, asset price_per_gft, asset gft_amount)
+    {
         buyorder_table b_t (get_self(), get_self().value);
+        uint64_t order_id = b_t.available_primary_key();
         b_t.emplace (get_self(), [&](auto &b) {
-            b.order_id = b_t.available_primary_key();
+            b.order_id = order_id;
             b.buyer = buyer;
             b.price_per_gft = price_per_gft;
             b.gft_amount = gft_amount;
             b.order_value = get_eos_order_value(price_per_gft, gft_amount);
             b.created_date = current_block_time().to_time_point().sec_since_epoch();
         });
+        return order_id;
     }
 
-    void add_limitsell_order (name seller, asset price_per_gft, asset gft_amount)
+    uint64_t add_limitsell_order (name seller, asset price_per_gft, asset gft_amount, bool check_balance = true)
     {
         eosio::check (price_per_gft.amount > 0, "Price must be greater than zero.");
         eosio::check (gft_amount.amount > 0, "GFT amount must be greater than zero.");
 
         permit_selling (seller, gft_amount);
 
-        confirm_balance (seller, gft_amount);
+        if (check_balance) {
+            confirm_balance (seller, gft_amount);
+        }
         increase_sellgft_liquidity (gft_amount, get_eos_order_value (price_per_gft, gft_amount), 1);
 
+        return emplace_sell_order (seller, price_per_gft, gft_amount);
+    }
+
+    // inserts the order row only; the caller has checked the balance and updated the liquidity
+    uint64_t emplace_sell_order (name seller, asset price_per_gft, asset gft_amount)
+    {
         sellorder_table s_t (get_self(), get_self().value);
+        uint64_t order_id = s_t.available_primary_key();
         s_t.emplace (get_self(), [&](auto &s) {
-            s.order_id = s_t.available_primary_key();
+            s.order_id = order_id;
             s.seller = seller;
             s.price_per_gft = price_per_gft;
             s.gft_amount = gft_amount;
             s.order_value = get_eos_order_value (price_per_gft, gft_amount);
             s.created_date = current_block_time().to_time_point().sec_since_epoch();
         });
+        return order_id;
+    }
+
+    // Deposit memos that also place an order with the deposited funds:
+    //   limit:<price>   e.g. "limit:0.0150 EOS"; an EOS deposit buys GFT at up to the price,
+    //                   a GFT deposit sells it at the price
+    //   market          an EOS deposit buys from the lowest asks
+    //   ladder          an EOS deposit starts stackbuy, a GFT deposit stacksell
+    // Any other memo is a plain deposit. A limit order is reported like one from limitbuygft or
+    // limitsellgft; market and ladder report like marketbuy and stackbuy/stacksell. The transfer already carries the depositor's
+    // authority, and the order never exceeds the deposit just credited, so the balance
+    // checks of the order actions are skipped.
+    void place_from_memo (name account, asset quantity, const string& memo)
+    {
+        const string limit_prefix = "limit:";
+        bool is_limit = memo.compare (0, limit_prefix.size(), limit_prefix) == 0;
+        if (!is_limit && memo != "market" && memo != "ladder") {
+            return;
+        }
+
+        config_table config (get_self(), get_self().value);
+        auto c = config.get();
+        symbol gft_symbol = symbol{symbol_code(GYFTIE_SYM_STR.c_str()), GYFTIE_PRECISION};
+        bool is_buy = quantity.symbol != gft_symbol;
+
+        eosio::check (is_gyftie_account (account), "Depositor is not a gyftie account.");
+
+        if (is_limit) {
+            asset price = parse_price (memo.substr (limit_prefix.size()), c.valid_counter_token_symbol);
+            asset gft_amount = is_buy ? get_gft_amount (price, quantity) : quantity;
+            uint64_t order_id = is_buy ? add_limitbuy_order (account, price, gft_amount, false)
+                                       : add_limitsell_order (account, price, gft_amount, false);
+
+            begin_placed_order (order_id, is_buy, price, gft_amount);
+            processbook ();
+            end_placed_orders (account);
+        } else if (memo == "market") {
+            eosio::check (is_buy, "Instant sell order functionality is currently undergoing maintenance.");
+            marketbuyr (account, quantity);
+            send_trades ();
+        } else if (is_buy) {
+            start_stackbuy (account, quantity);
+        } else {
+            start_stacksell (account, quantity, c);
+        }
+    }
+
+    void start_stackbuy (name buyer, asset eos_amount)
+    {
+        asset price = asset {  std::max (get_lowest_sell().amount - 1, (int64_t) 1), eos_amount.symbol };
+        float share = 0.01000000;
+        asset order_eos =  adjust_asset(eos_amount, share);
+
+        eosio::transaction out{};
+        out.actions.emplace_back(permission_level{get_self(), "owner"_n}, 
+                                get_self(), "stackbuyrec"_n, 
+                                std::make_tuple(buyer,
+                                                eos_amount,
+                                                eos_amount * 0,
+                                                order_eos,
+                                                price,
+                                                1,
+                                                1));
+
+        out.delay_sec = 2;
+        out.send(get_next_sender_id(), get_self());
+    }
+
+    void start_stacksell (name seller, asset gft_amount, const Config& c)
+    {
+        asset price = get_highest_buy() + asset { 200, c.valid_counter_token_symbol};
+        float share = 0.01000000;
+
+        asset order_gft = adjust_asset(gft_amount, share);
+
+        eosio::transaction out{};
+        out.actions.emplace_back(permission_level{get_self(), "owner"_n}, 
+                                get_self(), "stacksellrec"_n, 
+                                std::make_tuple(seller,
+                                                gft_amount,
+                                                gft_amount * 0,
+                                                order_gft,
+                                                price,
+                                                1,
+                                                1));
+
+        out.delay_sec = 2;
+        out.send(get_next_sender_id(), get_self());
+    }
+
+    // Parses a price such as "0.0150 EOS" or "0.015" in the counter token symbol.
+    asset parse_price (const string& text, const symbol& sym)
+    {
+        size_t space = text.find (' ');
+        string number = text.substr (0, space);
+        if (space != string::npos) {
+            eosio::check (text.substr (space + 1) == sym.code().to_string(), "Memo price must be in the counter token symbol.");
+        }
+
+        size_t dot = number.find ('.');
+        string digits = number.substr (0, dot);
+        string fraction = dot == string::npos ? "" : number.substr (dot + 1);
+        eosio::check (fraction.size() <= sym.precision(), "Memo price has too many decimal places.");
+        fraction.append (sym.precision() - fraction.size(), '0');
+
+        int64_t amount = 0;
+        for (char ch : digits + fraction) {
+            eosio::check (ch >= '0' && ch <= '9' && amount < (asset::max_amount - 9) / 10, "Memo price is not a valid amount.");
+            amount = amount * 10 + (ch - '0');
+        }
+        return asset {amount, sym};
     }
 
     void permit_selling (name seller, asset sell_amount) {
@@ -775,11 +1038,7 @@ CONTRACT gftorderbook : public contract
         sendfrombal (c.gyftiecontract, seller, seller, taker_fee_to_seller_gft, "Market Maker Reward");
         set_last_price (price);
 
-        action(
-            permission_level{get_self(), "owner"_n},
-            get_self(), "tradeexec"_n,
-            std::make_tuple(buyer, seller, seller, gft_amount, price, taker_fee_to_seller_gft))
-        .send();
+        pass_fills.push_back (Fill {buyer, seller, seller, gft_amount, price, taker_fee_to_seller_gft});
     }
 
     void settle_buyer_maker (name buyer, name seller, asset price, asset gft_amount)
@@ -813,11 +1072,27 @@ CONTRACT gftorderbook : public contract
         set_last_price (price);
         // decrease_buygft_liquidity (gft_amount);
 
+        pass_fills.push_back (Fill {buyer, seller, buyer, gft_amount, price, taker_fee_to_buyer_eos});
+    }
+
+    // Reports the fills collected since the last call in one inline tradesbatch. The matching
+    // actions recurse, so every exit calls this: the innermost one sends the whole pass and the
+    // others find nothing left to send.
+    void send_trades ()
+    {
+        if (pass_fills.empty()) {
+            return;
+        }
+
+        update_candles ();
+
+        perf::stats::count (perf::INLINE_ACTIONS);
         action(
             permission_level{get_self(), "owner"_n},
-            get_self(), "tradeexec"_n,
-            std::make_tuple(buyer, seller, buyer, gft_amount, price, taker_fee_to_buyer_eos))
+            get_self(), "tradesbatch"_n,
+            std::make_tuple(pass_fills))
         .send();
+        pass_fills.clear();
     }
 
     void buygft (uint64_t sellorder_id, name buyer, asset eos_to_spend) 
@@ -872,6 +1147,110 @@ CONTRACT gftorderbook : public contract
         }    
     }
 
+    Quote get_quote (asset quantity)
+    {
+        config_table config (get_self(), get_self().value);
+        auto c = config.get();
+        symbol gft_symbol = symbol{symbol_code(GYFTIE_SYM_STR.c_str()), GYFTIE_PRECISION};
+
+        eosio::check (quantity.amount > 0, "Quantity must be greater than zero.");
+        eosio::check (quantity.symbol == c.valid_counter_token_symbol || quantity.symbol == gft_symbol,
+            "Quantity must be in the counter token or GFT.");
+
+        if (quantity.symbol == gft_symbol) {
+            return quote_sell (quantity, c.valid_counter_token_symbol);
+        }
+        return quote_buy (quantity, gft_symbol);
+    }
+
+    // Walks the asks the way marketbuyr fills them, without writing anything.
+    Quote quote_buy (asset eos_amount, symbol gft_symbol)
+    {
+        Quote q = empty_quote (eos_amount.symbol, gft_symbol, eos_amount.symbol);
+
+        sellorder_table s_t (get_self(), get_self().value);
+        auto s_index = s_t.get_index<"byprice"_n>();
+        auto s_itr = s_index.begin();
+        asset remainder_to_spend = eos_amount;
+
+        while (remainder_to_spend.amount > 0 && s_itr != s_index.end()) {
+            asset eos_spent = asset { std::min (remainder_to_spend.amount, s_itr->order_value.amount),
+                                      remainder_to_spend.symbol };
+            asset gft_amount = get_gft_amount (s_itr->price_per_gft, eos_spent);
+
+            q.spent += eos_spent;
+            q.filled += gft_amount;
+            q.fee += gft_amount - adjust_asset (gft_amount, 1 - MAKER_REWARD);
+            q.worst_price = s_itr->price_per_gft;
+            q.orders_touched++;
+
+            remainder_to_spend -= s_itr->order_value;
+            s_itr++;
+            perf::stats::count (perf::INDEX_STEPS);
+        }
+
+        q.unfilled.amount = std::max (remainder_to_spend.amount, (int64_t) 0);
+        q.average_price = get_average_price (q.spent, q.filled);
+        return q;
+    }
+
+    // Walks the bids the way marketsell fills them, without writing anything.
+    Quote quote_sell (asset gft_amount, symbol eos_symbol)
+    {
+        Quote q = empty_quote (gft_amount.symbol, eos_symbol, eos_symbol);
+
+        buyorder_table b_t (get_self(), get_self().value);
+        auto b_index = b_t.get_index<"byprice"_n>();
+        auto b_itr = b_index.rbegin();
+        asset remainder_to_sell = gft_amount;
+
+        while (remainder_to_sell.amount > 0 && b_itr != b_index.rend()) {
+            asset gft_sold = asset { std::min (remainder_to_sell.amount, b_itr->gft_amount.amount),
+                                     remainder_to_sell.symbol };
+            asset eos_amount = get_eos_order_value (b_itr->price_per_gft, gft_sold);
+
+            q.spent += gft_sold;
+            q.filled += eos_amount;
+            q.fee += eos_amount - adjust_asset (eos_amount, 1 - MAKER_REWARD);
+            q.worst_price = b_itr->price_per_gft;
+            q.orders_touched++;
+
+            remainder_to_sell -= b_itr->gft_amount;
+            b_itr++;
+            perf::stats::count (perf::INDEX_STEPS);
+        }
+
+        q.unfilled.amount = std::max (remainder_to_sell.amount, (int64_t) 0);
+        q.average_price = get_average_price (q.filled, q.spent);
+        return q;
+    }
+
+    Quote empty_quote (symbol spent_symbol, symbol filled_symbol, symbol eos_symbol)
+    {
+        Quote q;
+        q.spent = asset {0, spent_symbol};
+        q.filled = asset {0, filled_symbol};
+        q.fee = asset {0, filled_symbol};
+        q.average_price = asset {0, eos_symbol};
+        q.worst_price = asset {0, eos_symbol};
+        q.orders_touched = 0;
+        q.unfilled = asset {0, spent_symbol};
+        return q;
+    }
+
+    // EOS per whole GFT, rounded down
+    asset get_average_price (asset eos_amount, asset gft_amount)
+    {
+        if (gft_amount.amount == 0) {
+            return asset {0, eos_amount.symbol};
+        }
+        int128_t gft_unit = 1;
+        for (uint8_t i = 0; i < gft_amount.symbol.precision(); i++) {
+            gft_unit *= 10;
+        }
+        return asset { static_cast<int64_t>(int128_t{eos_amount.amount} * gft_unit / gft_amount.amount), eos_amount.symbol };
+    }
+
     void sellgft (uint64_t buyorder_id, name seller, asset gft_to_sell) 
     {
         // require_auth (seller);
@@ -909,17 +1288,160 @@ CONTRACT gftorderbook : public contract
         return order_value;
     }
 
+    // Floored, so the GFT bought never costs more than eos_amount; a float quotient can round up.
     asset get_gft_amount (asset price_per_gft, asset eos_amount)
     {
-        // print (" Price per GFT: ", price_per_gft, "\n");
-        // print (" EOS Amount: ", eos_amount, "\n");
+        eosio::check (price_per_gft.amount > 0, "Price must be greater than zero.");
 
         symbol gft_symbol = symbol{symbol_code(GYFTIE_SYM_STR.c_str()), GYFTIE_PRECISION};
-        float gft_quantity = pow(10,GYFTIE_PRECISION) * eos_amount.amount / price_per_gft.amount;
-        // print (" GFT Quantity: ", gft_quantity, "\n");
-        // print (" GFT Amount: ", asset { static_cast<int64_t>(gft_quantity), gft_symbol }, "\n");
+        int128_t gft_unit = 1;
+        for (uint8_t i = 0; i < GYFTIE_PRECISION; i++) {
+            gft_unit *= 10;
+        }
+        int128_t gft_quantity = int128_t{eos_amount.amount} * gft_unit / price_per_gft.amount;
+        eosio::check (gft_quantity <= asset::max_amount, "GFT amount is out of range.");
         return asset { static_cast<int64_t>(gft_quantity), gft_symbol };
-        //return gft_amount;
+    }
+
+    void begin_placed_order (uint64_t order_id, bool is_buy, asset price_per_gft, asset gft_amount)
+    {
+        OrderResult r;
+        r.side = is_buy ? "buy"_n : "sell"_n;
+        r.order_id = order_id;
+        r.filled_gft = asset {0, gft_amount.symbol};
+        r.filled_eos = asset {0, price_per_gft.symbol};
+        r.fee = asset {0, is_buy ? gft_amount.symbol : price_per_gft.symbol};
+        r.maker_reward = asset {0, is_buy ? price_per_gft.symbol : gft_amount.symbol};
+        r.remaining_gft = asset {0, gft_amount.symbol};
+        placed_orders.push_back (r);
+    }
+
+    // Reports the placed orders in one inline orderresults, with what is left of each on the book.
+    // Orders that all went straight onto the book without a fill report nothing.
+    void end_placed_orders (name account)
+    {
+        bool filled = std::any_of (placed_orders.begin(), placed_orders.end(),
+            [](const OrderResult& r) { return r.filled_gft.amount > 0; });
+        if (!filled) {
+            placed_orders.clear();
+            return;
+        }
+
+        buyorder_table b_t (get_self(), get_self().value);
+        sellorder_table s_t (get_self(), get_self().value);
+        for (auto& r : placed_orders) {
+            if (r.side == "buy"_n) {
+                auto b_itr = b_t.find (r.order_id);
+                if (b_itr != b_t.end()) {
+                    r.remaining_gft = b_itr->gft_amount;
+                }
+            } else {
+                auto s_itr = s_t.find (r.order_id);
+                if (s_itr != s_t.end()) {
+                    r.remaining_gft = s_itr->gft_amount;
+                }
+            }
+            perf::stats::count (perf::ROWS_READ);
+        }
+
+        perf::stats::count (perf::INLINE_ACTIONS);
+        action(
+            permission_level{get_self(), "owner"_n},
+            get_self(), "orderresults"_n,
+            std::make_tuple(account, placed_orders))
+        .send();
+        placed_orders.clear();
+    }
+
+    // Adds a fill to the placed orders on either side of it. The fee and reward are the
+    // MAKER_REWARD share that the settle_*_maker functions move to the maker.
+    void record_fill (uint64_t buyorder_id, uint64_t sellorder_id, asset price, asset gft_amount, bool seller_maker)
+    {
+        if (placed_orders.empty()) {
+            return;
+        }
+
+        asset eos_amount = get_eos_order_value (price, gft_amount);
+        asset gft_share = gft_amount - adjust_asset (gft_amount, 1 - MAKER_REWARD);
+        asset eos_share = eos_amount - adjust_asset (eos_amount, 1 - MAKER_REWARD);
+
+        for (auto& r : placed_orders) {
+            bool is_buy = r.side == "buy"_n;
+            if (r.order_id != (is_buy ? buyorder_id : sellorder_id)) {
+                continue;
+            }
+
+            r.filled_gft += gft_amount;
+            r.filled_eos += eos_amount;
+            if (is_buy) {
+                if (seller_maker) {
+                    r.fee += gft_share;
+                } else {
+                    r.maker_reward += eos_share;
+                }
+            } else {
+                if (seller_maker) {
+                    r.maker_reward += gft_share;
+                } else {
+                    r.fee += eos_share;
+                }
+            }
+        }
+    }
+
+    // Folds the pass into one candle per interval: all fills of a pass share the block time, so
+    // each fill is O(1) in memory and each interval costs one row read and one write per pass.
+    void update_candles ()
+    {
+        uint32_t now = current_block_time().to_time_point().sec_since_epoch();
+
+        candle pass;
+        pass.open = pass_fills.front().price;
+        pass.high = pass.open;
+        pass.low = pass.open;
+        pass.close = pass_fills.back().price;
+        pass.volume_gft = asset {0, pass_fills.front().gft_amount.symbol};
+        pass.volume_eos = asset {0, pass.open.symbol};
+        pass.trade_count = pass_fills.size();
+        for (const auto& fill : pass_fills) {
+            pass.high = std::max (pass.high, fill.price);
+            pass.low = std::min (pass.low, fill.price);
+            pass.volume_gft += fill.gft_amount;
+            pass.volume_eos += get_eos_order_value (fill.price, fill.gft_amount);
+        }
+
+        for (int i = 0; i < CANDLE_INTERVAL_COUNT; i++) {
+            uint32_t open_time = now - now % CANDLE_INTERVALS[i];
+            uint64_t slot = (open_time / CANDLE_INTERVALS[i]) % CANDLE_RING_SIZES[i];
+
+            candle_table c_t (get_self(), CANDLE_INTERVALS[i]);
+            auto c_itr = c_t.find (slot);
+            perf::stats::count (perf::ROWS_READ);
+            perf::stats::count (perf::ROWS_WRITTEN);
+
+            if (c_itr == c_t.end()) {
+                c_t.emplace (get_self(), [&](auto &c) {
+                    c = pass;
+                    c.slot = slot;
+                    c.open_time = open_time;
+                });
+            } else if (c_itr->open_time != open_time) {
+                c_t.modify (c_itr, get_self(), [&](auto &c) {
+                    c = pass;
+                    c.slot = slot;
+                    c.open_time = open_time;
+                });
+            } else {
+                c_t.modify (c_itr, get_self(), [&](auto &c) {
+                    c.high = std::max (c.high, pass.high);
+                    c.low = std::min (c.low, pass.low);
+                    c.close = pass.close;
+                    c.volume_gft += pass.volume_gft;
+                    c.volume_eos += pass.volume_eos;
+                    c.trade_count += pass.trade_count;
+                });
+            }
+        }
     }
 
     void match_order (uint64_t sellorder_id, uint64_t buyorder_id)
@@ -941,8 +1463,10 @@ CONTRACT gftorderbook : public contract
         // if seller is market maker
         if (s_itr->created_date < b_itr->created_date) {
             settle_seller_maker (b_itr->buyer, s_itr->seller, s_itr->price_per_gft, gft_amount);
+            record_fill (buyorder_id, sellorder_id, s_itr->price_per_gft, gft_amount, true);
         } else { // buyer is market maker
             settle_buyer_maker(b_itr->buyer, s_itr->seller, b_itr->price_per_gft, gft_amount);
+            record_fill (buyorder_id, sellorder_id, b_itr->price_per_gft, gft_amount, false);
         }
 
         if (b_itr->gft_amount == s_itr->gft_amount) {
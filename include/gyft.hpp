@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include <eosio/transaction.hpp>
+
 #include "common.hpp"
 #include "profile.hpp"
 #include "gyftie.hpp"
@@ -16,6 +18,13 @@ class GyftClass {
 
     public:
 
+        // order-independent key so a gyft in either direction is found with one lookup
+        static uint128_t relationship_key (const name& a, const name& b) {
+            uint64_t low = std::min (a.value, b.value);
+            uint64_t high = std::max (a.value, b.value);
+            return (uint128_t{low} << 64) | high;
+        }
+
         struct [[ eosio::table, eosio::contract("gyftietoken") ]] Gyft
         {
             uint64_t    gyft_id;
@@ -31,6 +40,7 @@ class GyftClass {
             uint64_t    by_gyfter() const { return gyfter.value; }
             uint64_t    by_gyftee() const { return gyftee.value; }
             uint64_t    by_gyftdate() const { return gyft_date; }
+            uint128_t   by_relationship() const { return relationship_key (gyfter, gyftee); }
         };
 
         typedef eosio::multi_index<"gyfts"_n, Gyft,
@@ -39,16 +49,50 @@ class GyftClass {
             indexed_by<"bygyftee"_n,
                 const_mem_fun<Gyft, uint64_t, &Gyft::by_gyftee>>,
             indexed_by<"bygyftdate"_n, 
-                const_mem_fun<Gyft, uint64_t, &Gyft::by_gyftdate>>
+                const_mem_fun<Gyft, uint64_t, &Gyft::by_gyftdate>>,
+            indexed_by<"byrelation"_n,
+                const_mem_fun<Gyft, uint128_t, &Gyft::by_relationship>>
             >
         gyft_table;
 
-        name            contract;
-        gyft_table      gyft_t;
-        GyftieClass     gyftieClass;
+        // gyfts are throttled over a rolling 24 hour window, counted in hourly buckets; the
+        // first window is seeded from the gyfts table, so gyfts made in the day before the
+        // window existed are counted too
+        static constexpr uint32_t   THROTTLE_BUCKET_SECONDS     = 60 * 60;
+        static constexpr uint32_t   THROTTLE_BUCKETS            = 24;
+
+        struct [[ eosio::table, eosio::contract("gyftietoken") ]] GyftWindow
+        {
+            uint32_t            newest_bucket   = 0;
+            uint32_t            window_total    = 0;
+            vector<uint32_t>    bucket_counts   = vector<uint32_t> (THROTTLE_BUCKETS, 0);
+        };
+
+        typedef singleton<"gyftwindows"_n, GyftWindow> gyftwindow_table;
+        typedef eosio::multi_index<"gyftwindows"_n, GyftWindow> gyftwindow_table_placeholder;
+
+        // byrelation only has entries for gyfts written since it was added; reindex rewrites the
+        // older rows and sets relations_indexed once it has been through the whole table
+        static constexpr uint32_t   REINDEX_BATCH               = 10;
+
+        struct [[ eosio::table, eosio::contract("gyftietoken") ]] GyftIndex
+        {
+            bool                relations_indexed   = false;
+        };
+
+        typedef singleton<"gyftindexes"_n, GyftIndex> gyftindex_table;
+        typedef eosio::multi_index<"gyftindexes"_n, GyftIndex> gyftindex_table_placeholder;
+
+        name                contract;
+        gyft_table          gyft_t;
+        gyftwindow_table    gyftwindow_t;
+        gyftindex_table     gyftindex_t;
+        GyftieClass         gyftieClass;
 
         GyftClass (const name& contract) 
             : gyft_t (contract, contract.value), 
+            gyftwindow_t (contract, contract.value),
+            gyftindex_t (contract, contract.value),
             gyftieClass (contract),
             contract (contract) {}
 
@@ -58,7 +102,11 @@ class GyftClass {
             const asset& gyfter_issue,
             const asset& gyftee_issue, 
             const string& relationship) {
-                        
+
+            // read before the new gyft is written, so a first window seeded from the table does
+            // not count it twice
+            GyftWindow window = get_window ();
+
             gyft_t.emplace(contract, [&](auto &g) {
                 g.gyft_id       = gyft_t.available_primary_key();
                 g.gyfter        = gyfter;
@@ -68,26 +116,119 @@ class GyftClass {
                 g.relationship  = relationship;
                 g.gyft_date     = current_block_time().to_time_point().sec_since_epoch();
             });
+
+            window.bucket_counts[window.newest_bucket % THROTTLE_BUCKETS]++;
+            window.window_total++;
+            gyftwindow_t.set (window, contract);
+        }
+
+        // whether gyfter has sent gyftee a gyft
+        bool gyfted (const name& gyfter, const name& gyftee) {
+            if (gyftindex_t.get_or_default (GyftIndex()).relations_indexed) {
+                auto relationship_index = gyft_t.get_index<"byrelation"_n>();
+                uint128_t key = relationship_key (gyfter, gyftee);
+                auto r_itr = relationship_index.find (key);
+                while (r_itr != relationship_index.end() && r_itr->by_relationship() == key) {
+                    perf::stats::count (perf::INDEX_STEPS);
+                    if (r_itr->gyfter == gyfter) {
+                        return true;
+                    }
+                    r_itr++;
+                }
+                return false;
+            }
+
+            auto gyfter_index = gyft_t.get_index<"bygyfter"_n>();
+            auto gyfter_itr = gyfter_index.find (gyfter.value);
+            while (gyfter_itr != gyfter_index.end() && gyfter_itr->gyfter == gyfter) {
+                perf::stats::count (perf::INDEX_STEPS);
+                if (gyfter_itr->gyftee == gyftee) {
+                    return true;
+                }
+                gyfter_itr++;
+            }
+            return false;
+        }
+
+        // Secondary index entries are only written with the row, so each older gyft is erased
+        // and emplaced again unchanged. Continues in a deferred action until the table is done.
+        void reindex (const uint64_t& start_gyft_id) {
+            uint32_t gyft_count = 0;
+
+            auto g_itr = gyft_t.lower_bound (start_gyft_id);
+            while (g_itr != gyft_t.end() && gyft_count < REINDEX_BATCH) {
+                Gyft gyft = *g_itr;
+                g_itr = gyft_t.erase (g_itr);
+                gyft_t.emplace (contract, [&](auto &g) {
+                    g = gyft;
+                });
+                gyft_count++;
+            }
+
+            if (g_itr != gyft_t.end()) {
+                eosio::transaction out{};
+                out.actions.emplace_back(permission_level{contract, "owner"_n}, 
+                                        contract, "indexgyfts"_n, 
+                                        std::make_tuple(g_itr->gyft_id));
+                out.delay_sec = 1;
+                out.send(gyftieClass.get_next_sender_id(), contract);
+                return;
+            }
+
+            GyftIndex index = gyftindex_t.get_or_default (GyftIndex());
+            index.relations_indexed = true;
+            gyftindex_t.set (index, contract);
         }
 
         void throttle_check () {
             uint32_t throttle = gyftieClass.get_state().throttle;
             
             if (throttle < gyftieClass.get_state().account_count && throttle > 0) {
-                auto gyftdate_index = gyft_t.get_index<"bygyftdate"_n>();
-                auto gyftdate_itr = gyftdate_index.rbegin();
+                check (get_window().window_total <= throttle, 
+                                "Gyfts are throttled. Please wait a few hours and try again.");
+            }
+        }
+
+        // returns the window rolled forward to the current bucket; expired buckets are zeroed
+        GyftWindow get_window () {
+            uint32_t current_bucket = current_block_time().to_time_point().sec_since_epoch() / THROTTLE_BUCKET_SECONDS;
+            if (!gyftwindow_t.exists()) {
+                return seed_window (current_bucket);
+            }
+
+            GyftWindow window = gyftwindow_t.get();
 
-                for (int i=0; i< throttle; i++) {
-                    gyftdate_itr++;
+            if (current_bucket > window.newest_bucket) {
+                uint32_t expired = std::min (current_bucket - window.newest_bucket, THROTTLE_BUCKETS);
+                for (uint32_t i = 1; i <= expired; i++) {
+                    uint32_t& bucket_count = window.bucket_counts[(window.newest_bucket + i) % THROTTLE_BUCKETS];
+                    window.window_total -= bucket_count;
+                    bucket_count = 0;
                 }
+                window.newest_bucket = current_bucket;
+            }
+            return window;
+        }
 
-                uint32_t throttled_gyfts_ago = gyftdate_itr->gyft_date;
-                uint32_t throttled_time_period = 60 * 60 * 24; // 24 hours
-                check (  throttled_gyfts_ago < 
-                                    current_block_time().to_time_point().sec_since_epoch() - 
-                                    throttled_time_period, 
-                                "Gyfts are throttled. Please wait a few hours and try again.");
+        // Counts the gyfts of the last THROTTLE_BUCKETS hours into a new window. Runs once, in
+        // the first gyft after the window was added, and reads one day of gyfts.
+        GyftWindow seed_window (const uint32_t& current_bucket) {
+            GyftWindow window;
+            window.newest_bucket = current_bucket;
+
+            uint32_t oldest_bucket = current_bucket >= THROTTLE_BUCKETS ? current_bucket - THROTTLE_BUCKETS + 1 : 0;
+            auto date_index = gyft_t.get_index<"bygyftdate"_n>();
+            auto g_itr = date_index.lower_bound (uint64_t{oldest_bucket} * THROTTLE_BUCKET_SECONDS);
+            while (g_itr != date_index.end()) {
+                perf::stats::count (perf::INDEX_STEPS);
+                uint32_t bucket = g_itr->gyft_date / THROTTLE_BUCKET_SECONDS;
+                if (bucket <= current_bucket) {
+                    window.bucket_counts[bucket % THROTTLE_BUCKETS]++;
+                    window.window_total++;
+                }
+                g_itr++;
             }
+            return window;
         }
 };
 
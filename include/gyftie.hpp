@@ -4,6 +4,7 @@
 #include <string>
 
 #include "common.hpp"
+#include "perfstats.hpp"
 #include "profile.hpp"
 
 using std::vector;
@@ -108,6 +109,11 @@ class GyftieClass {
 
       uint64_t get_next_sender_id()
       {
+         // every deferred send takes a sender id
+         perf::stats::count (perf::DEFERRED_SENDS);
+         perf::stats::count (perf::ROWS_READ);
+         perf::stats::count (perf::ROWS_WRITTEN);
+
          AppState state = appstate_t.get_or_create (contract, AppState());
 
          uint64_t return_senderid = state.last_sender_id;
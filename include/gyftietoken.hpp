@@ -2,6 +2,7 @@
 #define GYFTIETOKEN_H
 
 #include <eosio/asset.hpp>
+#include <eosio/binary_extension.hpp>
 #include <eosio/eosio.hpp>
 #include <eosio/crypto.hpp>
 #include <eosio/time.hpp>
@@ -22,8 +23,12 @@
 #include "migration.hpp"
 #include "lockchain.hpp"
 #include "comment.hpp"
+#include "blob.hpp"
+#include "note.hpp"
 #include "profile.hpp"
 #include "permissions.hpp"
+#include "perfstats.hpp"
+#include "trace.hpp"
 
 using std::string;
 using std::vector;
@@ -39,6 +44,9 @@ CONTRACT gyftietoken : public contract
     //  TEMPORARY actions needed for deployments
     ACTION xferzj ();
     ACTION addekey (const name& account, const string& key); 
+    ACTION indexgyfts (const uint64_t start_gyft_id);
+    ACTION indexverifs (const uint32_t max_rows);
+    ACTION countchalls (const name start_challenged);
     // ACTION backupprofs (const name& profile);
     // ACTION restoreprofs (const name& profile);
     
@@ -49,6 +57,7 @@ CONTRACT gyftietoken : public contract
     ACTION unpause();
     ACTION chgthrottle(const uint32_t throttle);
     ACTION setconfig(const name gftorderbook, const name gyftie_foundation, const name gyftieoracle);
+    ACTION setblobmode (const uint8_t mode);
     ACTION setusercnt (const uint32_t count);
     ACTION claim (const name account, const string claim_key);
     ACTION isstoskoracl (const name to, const asset quantity, const string memo);
@@ -106,6 +115,7 @@ CONTRACT gyftietoken : public contract
     ACTION addlockchain (const name account_to_lock, const string note );
     ACTION addlocknote (const name account_to_lock, const string note);
     ACTION unlockchain (const name account_to_unlock, const string note );
+    ACTION chainnext (const name root, const uint32_t batch_size);
     ACTION unlock (const name account_to_unlock, const string note);
 
     //   Proposal Actions
@@ -128,8 +138,24 @@ CONTRACT gyftietoken : public contract
                         const uint64_t& parent_id, 
                         const string& comment_text);
 
-    ACTION remcomment (const uint64_t& comment_id);
-    ACTION editcomment (const uint64_t& comment_id, const string& comment_text);
+    ACTION remcomment (const uint64_t& proposal_id, const name& profile, const uint64_t& comment_id);
+    ACTION editcomment (const uint64_t& proposal_id, const name& profile, const uint64_t& comment_id, const string& comment_text);
+
+#ifdef GYFTIE_PERFSTATS
+    // per-action work counters, see perfstats.hpp
+    TABLE perfstat
+    {
+        name        action;
+        uint64_t    calls           = 0;
+        uint64_t    rows_read       = 0;
+        uint64_t    rows_written    = 0;
+        uint64_t    index_steps     = 0;
+        uint64_t    inline_actions  = 0;
+        uint64_t    deferred_sends  = 0;
+        uint64_t    primary_key() const { return action.value; }
+    };
+    typedef eosio::multi_index<"perfstats"_n, perfstat> perfstat_table;
+#endif
 
   private:
    
@@ -141,6 +167,8 @@ CONTRACT gyftietoken : public contract
     BadgeClass badgeClass = BadgeClass (get_self());
     Migration migration = Migration (get_self());
     CommentClass commentClass = CommentClass (get_self());
+    BlobClass blobClass = BlobClass (get_self());
+    NoteClass noteClass = NoteClass (get_self());
 
     TABLE account
     {
@@ -171,9 +199,10 @@ CONTRACT gyftietoken : public contract
     {
         name            challenged_account;
         name            challenger_account;
-        vector<string>  challenge_notes;
+        vector<string>  challenge_notes;    // legacy; new notes are written to the notes log
         asset           challenge_stake;
         uint32_t        challenged_time;
+        binary_extension<bool>  stake_counted;  // set once challenge_stake is in challstakes
         uint64_t        primary_key () const { return challenged_account.value; }
         uint64_t        by_challenger() const { return challenger_account.value; }
     };
@@ -181,11 +210,19 @@ CONTRACT gyftietoken : public contract
         indexed_by<"bychallenger"_n,
             const_mem_fun<challenge, uint64_t, &challenge::by_challenger>>
     > challenge_table;
+
+    TABLE challengerstake
+    {
+        name            challenger_account;
+        asset           committed_stake;
+        uint64_t        primary_key () const { return challenger_account.value; }
+    };
+    typedef eosio::multi_index<"challstakes"_n, challengerstake> challengerstake_table;
   
     TABLE currency_stats
     {
         asset supply;
-        symbol symbol;
+        eosio::symbol symbol;
         name issuer;
         uint64_t primary_key() const { return supply.symbol.code().raw(); }
     };
@@ -232,20 +269,16 @@ CONTRACT gyftietoken : public contract
                   const asset token_amount,
                   const string memo)
     {
-        print("---------- Payment -----------\n");
-        print("Token Contract   : ", name{token_contract}, "\n");
-        print("From             : ", name{from}, "\n");
-        print("To               : ", name{to}, "\n");
-        print("Amount           : ", token_amount, "\n");
-        print("Memo             : ", memo, "\n");
+        perf::stats::count (perf::INLINE_ACTIONS);
+
+        TRACE_DEBUG ("payment", "contract", token_contract, "from", from, "to", to,
+                     "amount", token_amount, "memo", memo);
 
         action(
             permission_level{from, "owner"_n},
             token_contract, "transfer"_n,
             std::make_tuple(from, to, token_amount, memo))
             .send();
-
-        print("---------- End Payment -------\n");
     }
 
 
@@ -323,9 +356,57 @@ CONTRACT gyftietoken : public contract
             get_self(), "unstaked2"_n, 
             std::make_tuple(user, quantity));
         out.delay_sec = delay;
+        perf::stats::count (perf::DEFERRED_SENDS);
         out.send(current_block_time().to_time_point().sec_since_epoch() + user.value + delay, get_self());    
     }
 
+    asset get_challenge_stake (const name challenger_account)
+    {
+        challengerstake_table cs_t (get_self(), get_self().value);
+        auto cs_itr = cs_t.find (challenger_account.value);
+        if (cs_itr == cs_t.end()) {
+            return asset {0, common::S_GFT};
+        }
+        return cs_itr->committed_stake;
+    }
+
+    void add_challenge_stake (const name challenger_account, const asset stake)
+    {
+        challengerstake_table cs_t (get_self(), get_self().value);
+        auto cs_itr = cs_t.find (challenger_account.value);
+        if (cs_itr == cs_t.end()) {
+            cs_t.emplace (get_self(), [&](auto &cs) {
+                cs.challenger_account = challenger_account;
+                cs.committed_stake = stake;
+            });
+        } else {
+            cs_t.modify (cs_itr, get_self(), [&](auto &cs) {
+                cs.committed_stake += stake;
+            });
+        }
+    }
+
+    // challenges opened before challstakes existed are only in the total once countchalls has run
+    void sub_challenge_stake (const challenge& c)
+    {
+        if (!c.stake_counted.value_or (false)) {
+            return;
+        }
+
+        challengerstake_table cs_t (get_self(), get_self().value);
+        auto cs_itr = cs_t.find (c.challenger_account.value);
+        eosio::check (cs_itr != cs_t.end(), "Committed challenge stake not found for challenger.");
+
+        const asset& stake = c.challenge_stake;
+        if (cs_itr->committed_stake <= stake) {
+            cs_t.erase (cs_itr);
+        } else {
+            cs_t.modify (cs_itr, get_self(), [&](auto &cs) {
+                cs.committed_stake -= stake;
+            });
+        }
+    }
+
     void sub_balance(const name owner, const asset value)
     {
         accounts from_acnts(_self, owner.value);
@@ -344,9 +425,11 @@ CONTRACT gyftietoken : public contract
         });
 
         // update profile balances       
-        check (profileClass.existsInV2(owner), "Cannot subtract from balance. Account " + owner.to_string() + " must upgrade profile to version 2.");
+        common::lazy_check (profileClass.existsInV2(owner),
+            "Cannot subtract from balance. Account ", owner, " must upgrade profile to version 2.");
         auto p_itr = profileClass.profile2_t.find (owner.value);
-        eosio::check (p_itr != profileClass.profile2_t.end(), "Cannot subtract from balance. Account " + owner.to_string() + " profile not found.");
+        common::lazy_check (p_itr != profileClass.profile2_t.end(),
+            "Cannot subtract from balance. Account ", owner, " profile not found.");
 
         eosio::check (p_itr->gft_balance >= value, "overdrawn balance - GFT is staked");
 
@@ -381,10 +464,12 @@ CONTRACT gyftietoken : public contract
             });
         }
 
-        check (profileClass.existsInV2(owner), "Cannot add to balance. Account " + owner.to_string() + " must upgrade profile to version 2.");
+        common::lazy_check (profileClass.existsInV2(owner),
+            "Cannot add to balance. Account ", owner, " must upgrade profile to version 2.");
 
         auto p_itr = profileClass.profile2_t.find (owner.value);
-        eosio::check (p_itr != profileClass.profile2_t.end(), "Cannot add to balance. Account " + owner.to_string() + " profile not found.");
+        common::lazy_check (p_itr != profileClass.profile2_t.end(),
+            "Cannot add to balance. Account ", owner, " profile not found.");
 
         profileClass.profile2_t.modify (p_itr, get_self(), [&](auto &p) {
             p.gft_balance += value;
@@ -392,5 +477,16 @@ CONTRACT gyftietoken : public contract
     }
 };
 
+// Every ACTION above, for the apply() that perfstats builds use. Production dispatch is
+// generated from the ACTION declarations; an action left out of this list can still be
+// called there, but is not reachable in a perfstats build.
+#define GYFTIETOKEN_ACTIONS \
+    (xferzj)(addekey)(indexgyfts)(indexverifs)(countchalls)(addsig)(remsig)(pause)(unpause)(chgthrottle)(setconfig)(setblobmode)(setusercnt) \
+    (claim)(isstoskoracl)(upgrade)(reset)(smsverify)(create)(issue)(issuetostake)(transfer)(xfertostake) \
+    (requnstake)(unstaked2)(stake)(createbadge)(issuebadge)(unissuebadge)(issueidemp)(addhash)(createprof) \
+    (setrank)(voteforuser)(unvoteuser)(sellnotify)(buynotify)(accelunstake)(remprofprep)(removeprof) \
+    (verifyuser)(referuser)(nchallenge)(validate)(dchallenge)(addcnote)(addlock)(addlockchain)(addlocknote) \
+    (unlockchain)(chainnext)(unlock)(propose)(proposetrx)(execproposal)(votefor)(voteagainst)(unvoteprop) \
+    (removeprop)(addcomment)(remcomment)(editcomment)
 
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "common.hpp"
 #include "gyft.hpp"
+#include "note.hpp"
 
 using std::vector;
 using namespace eosio;
@@ -15,7 +16,7 @@ class LockClass  {
         struct [[ eosio::table, eosio::contract("gyftietoken") ]] Lock 
         {
             name            account;
-            vector<string>  lock_notes;
+            vector<string>  lock_notes;     // legacy; new notes are written to the notes log
             uint64_t        primary_key() const { return account.value; }
         };
 
@@ -25,20 +26,22 @@ class LockClass  {
         lock_table  lock_t;
         GyftClass   gyftClass;
         GyftieClass gyftieClass;
+        NoteClass   noteClass;
 
         LockClass (const name& contract) 
             : lock_t (contract, contract.value), 
             gyftClass (contract),
             gyftieClass (contract),
+            noteClass (contract),
             contract (contract){}
 
         iterator<std::bidirectional_iterator_tag, const Lock> lock (const name& account_to_lock, const string& note) {
 
             check (lock_t.find (account_to_lock.value) == lock_t.end(), "Account is already locked.");
 
+            noteClass.add_note (account_to_lock, "lock"_n, note);
             return lock_t.emplace (contract, [&](auto &l) {
                 l.account = account_to_lock;
-                l.lock_notes.push_back (note);
             });
         }
 
@@ -47,6 +50,7 @@ class LockClass  {
             auto l_itr = lock_t.find (account_to_unlock.value);
             check (l_itr != lock_t.end(), "Account is not locked.");
 
+            noteClass.remove_notes (account_to_unlock, "lock"_n);
             return lock_t.erase (l_itr);
         }
 
@@ -55,10 +59,7 @@ class LockClass  {
             auto l_itr = lock_t.find (locked_account.value);
             check (l_itr != lock_t.end(), "Account is not locked.");
 
-            lock_t.modify (l_itr, contract, [&](auto &l) {
-                l.lock_notes.push_back(note);
-            });
-
+            noteClass.add_note (locked_account, "lock"_n, note);
             return l_itr;
         }
 };
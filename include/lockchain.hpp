@@ -15,62 +15,197 @@ class LockChain  {
 
     public:
 
-    static void unlockchain (const name& contract, const name account_to_unlock, const string note)
-    {
-        // Permit::permit (contract, account_to_unlock, name{0}, Permit::ANY_SIGNATORY);
+    static constexpr uint8_t    LOCK_CHAIN      = 1;
+    static constexpr uint8_t    UNLOCK_CHAIN    = 2;
+
+    // rows handled per action: accounts taken off the frontier, gyfts read for them, or
+    // visited rows cleared
+    static constexpr uint32_t   CHAIN_BATCH     = 25;
 
-        GyftieClass gyftieClass = GyftieClass (contract);
+    static constexpr uint64_t   NO_GYFT         = -1;
 
+    // one row per running traversal, keyed by the account the chain started from
+    struct [[ eosio::table, eosio::contract("gyftietoken") ]] ChainJob
+    {
+        name        root;
+        uint8_t     mode;
+        string      note;
+        uint64_t    next_seq            = 0;
+        uint32_t    accounts_visited    = 0;
+        uint64_t    next_gyft_id        = NO_GYFT;  // where the frontier head's gyfts resume
+        uint64_t    primary_key() const { return root.value; }
+    };
+    typedef eosio::multi_index<"chainjobs"_n, ChainJob> chainjob_table;
+
+    // FIFO of accounts still to process; scoped by root
+    struct [[ eosio::table, eosio::contract("gyftietoken") ]] ChainFrontier
+    {
+        uint64_t    seq;
+        name        account;
+        uint64_t    primary_key() const { return seq; }
+    };
+    typedef eosio::multi_index<"chainfront"_n, ChainFrontier> chainfrontier_table;
+
+    // accounts already queued by this traversal; scoped by root
+    struct [[ eosio::table, eosio::contract("gyftietoken") ]] ChainVisited
+    {
+        name        account;
+        uint64_t    primary_key() const { return account.value; }
+    };
+    typedef eosio::multi_index<"chainvisit"_n, ChainVisited> chainvisited_table;
+
+    static void unlockchain (const name& contract, const name account_to_unlock, const string note)
+    {
         LockClass lockClass = LockClass (contract);
         lockClass.unlock (account_to_unlock, note);
 
-        GyftClass gyftClass = GyftClass (contract);
-        auto gyfter_index = gyftClass.gyft_t.get_index<"bygyfter"_n>();
-        auto gyfter_itr = gyfter_index.find (account_to_unlock.value);
-        if (gyfter_itr == gyfter_index.end()) {
-            return;
-        }
+        start (contract, account_to_unlock, note, UNLOCK_CHAIN);
+    }
 
-        while (gyfter_itr->gyfter == account_to_unlock && gyfter_itr != gyfter_index.end()) {
-            eosio::transaction out{};
-            out.actions.emplace_back(permission_level{contract, "owner"_n}, 
-                                    contract, "unlockchain"_n, 
-                                    std::make_tuple(gyfter_itr->gyftee, note));
-            out.delay_sec = 1;
-            out.send(gyftieClass.get_next_sender_id(), contract);    
+    static void lockchain (const name& contract, const name account_to_lock, const string note)
+    {
+        LockClass lockClass = LockClass (contract);
+        lockClass.lock (account_to_lock, note);
 
-            gyfter_itr++;
-        }
+        start (contract, account_to_lock, note, LOCK_CHAIN);
     }
 
-    static void lockchain (const name& contract, const name account_to_lock, const string note)
+    static void next (const name& contract, const name& root, const uint32_t& batch_size)
     {
-        // Permit::permit (contract, account_to_unlock, name{0}, Permit::ANY_SIGNATORY);
+        check (batch_size > 0, "Batch size must be greater than zero.");
 
-        GyftieClass gyftieClass = GyftieClass (contract);
+        chainjob_table job_t (contract, contract.value);
+        auto j_itr = job_t.find (root.value);
+        common::lazy_check (j_itr != job_t.end(), "Lock chain traversal not found for account: ", root);
 
-        LockClass lockClass = LockClass (contract);
-        lockClass.lock (account_to_lock, note);
+        ChainJob job = *j_itr;
 
+        chainfrontier_table frontier_t (contract, root.value);
+        chainvisited_table visited_t (contract, root.value);
+
+        LockClass lockClass = LockClass (contract);
         GyftClass gyftClass = GyftClass (contract);
         auto gyfter_index = gyftClass.gyft_t.get_index<"bygyfter"_n>();
-        auto gyfter_itr = gyfter_index.find (account_to_lock.value);
-        if (gyfter_itr == gyfter_index.end()) {
-            return;
+
+        uint32_t processed = 0;
+        auto f_itr = frontier_t.begin();
+        while (f_itr != frontier_t.end() && processed < batch_size) {
+            const name account = f_itr->account;
+
+            auto gyfter_itr = gyfter_index.lower_bound (account.value);
+            if (job.next_gyft_id == NO_GYFT) {
+                apply (lockClass, job.mode, account, job.note);
+                processed++;
+            } else {
+                // the last batch ran out partway through this account's gyfts
+                auto g_itr = gyftClass.gyft_t.find (job.next_gyft_id);
+                if (g_itr != gyftClass.gyft_t.end() && g_itr->gyfter == account) {
+                    gyfter_itr = gyfter_index.iterator_to (*g_itr);
+                }
+                job.next_gyft_id = NO_GYFT;
+            }
+
+            while (gyfter_itr != gyfter_index.end() && gyfter_itr->gyfter == account && processed < batch_size) {
+                const name gyftee = gyfter_itr->gyftee;
+                if (visited_t.find (gyftee.value) == visited_t.end()) {
+                    visited_t.emplace (contract, [&](auto &v) {
+                        v.account = gyftee;
+                    });
+                    frontier_t.emplace (contract, [&](auto &f) {
+                        f.seq = job.next_seq;
+                        f.account = gyftee;
+                    });
+                    job.next_seq++;
+                    job.accounts_visited++;
+                }
+                gyfter_itr++;
+                processed++;
+            }
+
+            if (gyfter_itr != gyfter_index.end() && gyfter_itr->gyfter == account) {
+                job.next_gyft_id = gyfter_itr->gyft_id;
+                break;
+            }
+            f_itr = frontier_t.erase (f_itr);
+        }
+
+        // traversal is complete; clear the visited set within the same budget
+        if (frontier_t.begin() == frontier_t.end()) {
+            auto v_itr = visited_t.begin();
+            while (v_itr != visited_t.end() && processed < batch_size) {
+                v_itr = visited_t.erase (v_itr);
+                processed++;
+            }
+
+            if (visited_t.begin() == visited_t.end()) {
+                job_t.erase (j_itr);
+                return;
+            }
         }
 
-        while (gyfter_itr->gyfter == account_to_lock && gyfter_itr != gyfter_index.end()) {
-            eosio::transaction out{};
-            out.actions.emplace_back(permission_level{contract, "owner"_n}, 
-                                    contract, "lockchain"_n, 
-                                    std::make_tuple(gyfter_itr->gyftee, note));
-            out.delay_sec = 1;
-            out.send(gyftieClass.get_next_sender_id(), contract);    
+        job_t.modify (j_itr, contract, [&](auto &j) {
+            j.next_seq = job.next_seq;
+            j.accounts_visited = job.accounts_visited;
+            j.next_gyft_id = job.next_gyft_id;
+        });
 
-            gyfter_itr++;
+        schedule (contract, root);
+    }
+
+    private:
+
+    static void start (const name& contract, const name& root, const string& note, const uint8_t& mode)
+    {
+        chainjob_table job_t (contract, contract.value);
+        common::lazy_check (job_t.find (root.value) == job_t.end(),
+            "A lock chain traversal is already running from account: ", root);
+
+        job_t.emplace (contract, [&](auto &j) {
+            j.root = root;
+            j.mode = mode;
+            j.note = note;
+            j.next_seq = 1;
+            j.accounts_visited = 1;
+        });
+
+        chainvisited_table visited_t (contract, root.value);
+        visited_t.emplace (contract, [&](auto &v) {
+            v.account = root;
+        });
+
+        chainfrontier_table frontier_t (contract, root.value);
+        frontier_t.emplace (contract, [&](auto &f) {
+            f.seq = 0;
+            f.account = root;
+        });
+
+        next (contract, root, CHAIN_BATCH);
+    }
+
+    // downstream accounts may already be in the target state; skip them rather than fail the batch
+    static void apply (LockClass& lockClass, const uint8_t& mode, const name& account, const string& note)
+    {
+        bool locked = lockClass.lock_t.find (account.value) != lockClass.lock_t.end();
+        if (mode == LOCK_CHAIN && !locked) {
+            lockClass.lock (account, note);
+        } else if (mode == UNLOCK_CHAIN && locked) {
+            lockClass.unlock (account, note);
         }
     }
 
+    // The sender id is fixed per root and replaces any continuation still pending, so a manual
+    // chainnext does not leave a second deferred chain running for the same traversal.
+    static void schedule (const name& contract, const name& root)
+    {
+        perf::stats::count (perf::DEFERRED_SENDS);
+
+        eosio::transaction out{};
+        out.actions.emplace_back(permission_level{contract, "owner"_n},
+                                contract, "chainnext"_n,
+                                std::make_tuple(root, CHAIN_BATCH));
+        out.delay_sec = 1;
+        out.send((uint128_t{"chainnext"_n.value} << 64) | root.value, contract, true);
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
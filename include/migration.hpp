@@ -5,6 +5,7 @@
 #include <eosio/eosio.hpp>
 #include <eosio/multi_index.hpp>
 #include <eosio/asset.hpp>
+#include <eosio/transaction.hpp>
 
 #include "common.hpp"
 #include "gyftie.hpp"
@@ -67,11 +68,67 @@ class Migration {
             // }
         }
 
+        // Rewrites up to max_rows verifies, in byverified order from the saved cursor, so they
+        // enter byverifypair, and sets a verified account's verifycounts row once all of its rows
+        // are done; an account's rows can span calls. Counts are set rather than added to, so
+        // verifications made since the deploy are not counted twice: they have higher ids and
+        // come after the cursor. Continues in a deferred action until the table is done.
+        void indexverifs (const uint32_t& max_rows) {
+            ProfileClass::VerifyIndex progress = profileClass.verifyindex_t.get_or_default (ProfileClass::VerifyIndex());
+
+            auto verified_index = profileClass.verify_t.get_index<"byverified"_n>();
+            auto cursor_itr = profileClass.verify_t.find (progress.next_verify_id);
+            auto v_itr = verified_index.lower_bound (progress.next_verified.value);
+            if (cursor_itr != profileClass.verify_t.end() && cursor_itr->verified == progress.next_verified) {
+                v_itr = verified_index.iterator_to (*cursor_itr);
+            } else {
+                // the cursor row is gone, so the account is recounted from its first row
+                progress.account_rows = 0;
+            }
+
+            uint32_t rows = 0;
+            while (v_itr != verified_index.end() && rows < max_rows) {
+                ProfileClass::Verify verify = *v_itr;
+                v_itr++;
+
+                profileClass.verify_t.erase (profileClass.verify_t.find (verify.verify_id));
+                profileClass.verify_t.emplace (contract, [&](auto &v) {
+                    v = verify;
+                });
+                progress.account_rows++;
+                rows++;
+
+                if (v_itr == verified_index.end() || v_itr->verified != verify.verified) {
+                    profileClass.set_verified_count (verify.verified, progress.account_rows);
+                    progress.account_rows = 0;
+                }
+            }
+
+            if (v_itr != verified_index.end()) {
+                progress.next_verified = v_itr->verified;
+                progress.next_verify_id = v_itr->verify_id;
+                profileClass.verifyindex_t.set (progress, contract);
+
+                eosio::transaction out{};
+                out.actions.emplace_back(permission_level{contract, "owner"_n}, 
+                                        contract, "indexverifs"_n, 
+                                        std::make_tuple(max_rows));
+                out.delay_sec = 1;
+                out.send(gyftieClass.get_next_sender_id(), contract);
+                return;
+            }
+
+            // a later run starts again from the first verify
+            progress = ProfileClass::VerifyIndex();
+            progress.pairs_indexed = true;
+            profileClass.verifyindex_t.set (progress, contract);
+        }
+
         void backupprofs (const name& profile) {
             uint32_t prof_count = 0;
 
             auto p_itr = profileClass.profile_t.find (profile.value);
-            check (p_itr != profileClass.profile_t.end(), "Profile record for account not found: " + profile.to_string());
+            common::lazy_check (p_itr != profileClass.profile_t.end(), "Profile record for account not found: ", profile);
 
             while (p_itr != profileClass.profile_t.end() && prof_count < 10) {
                 copy_to_temp (p_itr->account);
@@ -93,7 +150,7 @@ class Migration {
             uint32_t prof_count = 0;
 
             auto tp_itr = tprofile_t.find (profile.value);
-            check (tp_itr != tprofile_t.end(), "Temp Profile record for account not found: " + profile.to_string());
+            common::lazy_check (tp_itr != tprofile_t.end(), "Temp Profile record for account not found: ", profile);
 
             while (tp_itr != tprofile_t.end() && prof_count < 10) {
                 copy_from_temp (tp_itr->account);
@@ -114,7 +171,7 @@ class Migration {
         void copy_to_temp (const name& profile) {
 
             auto p_itr = profileClass.profile_t.find (profile.value);
-            check (p_itr != profileClass.profile_t.end(), "Profile record for account not found: " + profile.to_string());
+            common::lazy_check (p_itr != profileClass.profile_t.end(), "Profile record for account not found: ", profile);
 
             tprofile_t.emplace (contract, [&](auto tp) {
                 tp.account = p_itr->account;
@@ -128,7 +185,7 @@ class Migration {
 
         void copy_from_temp (const name& profile) {
             auto tp_itr = tprofile_t.find (profile.value);
-            check (tp_itr != tprofile_t.end(), "Temp profile record from account not found: " + profile.to_string());
+            common::lazy_check (tp_itr != tprofile_t.end(), "Temp profile record from account not found: ", profile);
 
             profileClass.profile_t.emplace (contract, [&](auto p) {
                 p.account           = tp_itr->account;
@@ -0,0 +1,63 @@
+#ifndef NOTE_H
+#define NOTE_H
+
+#include <eosio/eosio.hpp>
+
+#include "blob.hpp"
+
+using std::string;
+using namespace eosio;
+
+class NoteClass {
+
+    public:
+
+        // Notes on an open challenge or lock, kept until that challenge or lock is closed. Scoped
+        // by the subject account; seq is assigned in insertion order so notes can be paged with
+        // lower_bound on the primary key. note_counted is whether the put took a blob reference.
+        struct [[ eosio::table, eosio::contract("gyftietoken") ]] Note
+        {
+            uint64_t        seq;
+            name            note_type;
+            checksum256     note_hash;
+            bool            note_counted        = false;
+            time_point_sec  created_date        = time_point_sec(current_time_point());
+
+            uint64_t        primary_key () const { return seq; }
+        };
+
+        typedef eosio::multi_index<"notes"_n, Note> note_table;
+
+        name            contract;
+        BlobClass       blobClass;
+
+        NoteClass (const name& contract) :
+            contract (contract),
+            blobClass (contract) {}
+
+        void add_note (const name& subject, const name& note_type, const string& note) {
+            note_table n_t (contract, subject.value);
+            n_t.emplace (contract, [&](auto &n) {
+                n.seq           = n_t.available_primary_key();
+                n.note_type     = note_type;
+                n.note_counted  = blobClass.counts (false);
+                n.note_hash     = blobClass.put (note);
+            });
+        }
+
+        // erases the subject's notes of one type and releases their blobs
+        void remove_notes (const name& subject, const name& note_type) {
+            note_table n_t (contract, subject.value);
+            auto n_itr = n_t.begin();
+            while (n_itr != n_t.end()) {
+                if (n_itr->note_type != note_type) {
+                    n_itr++;
+                    continue;
+                }
+                blobClass.release (n_itr->note_hash, n_itr->note_counted);
+                n_itr = n_t.erase (n_itr);
+            }
+        }
+};
+
+#endif
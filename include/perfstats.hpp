@@ -0,0 +1,76 @@
+#ifndef PERFSTATS_H
+#define PERFSTATS_H
+
+#include <eosio/eosio.hpp>
+
+using namespace eosio;
+
+// Per-action work counters. Build with -DGYFTIE_PERFSTATS to have the shared helpers count
+// rows read, rows written, secondary index steps, inline actions and deferred sends, and to
+// have apply() add them to the contract's "perfstats" table under the action name. Without
+// the flag perf::stats is the disabled policy: every call is an empty inline function and
+// neither the counters nor the table exist in the WASM.
+namespace perf {
+
+    enum counter : uint8_t {
+        ROWS_READ       = 0,
+        ROWS_WRITTEN    = 1,
+        INDEX_STEPS     = 2,
+        INLINE_ACTIONS  = 3,
+        DEFERRED_SENDS  = 4,
+        COUNTER_COUNT   = 5
+    };
+
+    template <bool Enabled>
+    struct Stats {
+        static void count (const counter, const uint64_t = 1) {}
+
+        template <typename Contract>
+        static void flush (const name&, const name&) {}
+    };
+
+    template <>
+    struct Stats<true> {
+        // one action runs per WASM instance, so the counters start at zero for each action
+        static inline uint64_t counters[COUNTER_COUNT] = {};
+
+        static void count (const counter c, const uint64_t n = 1) {
+            counters[c] += n;
+        }
+
+        // Contract::perfstat_table is only declared in GYFTIE_PERFSTATS builds
+        template <typename Contract>
+        static void flush (const name& contract, const name& action) {
+            typename Contract::perfstat_table p_t (contract, contract.value);
+            auto p_itr = p_t.find (action.value);
+            if (p_itr == p_t.end()) {
+                p_t.emplace (contract, [&](auto &p) {
+                    p.action = action;
+                    add (p);
+                });
+            } else {
+                p_t.modify (p_itr, contract, [&](auto &p) {
+                    add (p);
+                });
+            }
+        }
+
+        template <typename Row>
+        static void add (Row& p) {
+            p.calls++;
+            p.rows_read += counters[ROWS_READ];
+            p.rows_written += counters[ROWS_WRITTEN];
+            p.index_steps += counters[INDEX_STEPS];
+            p.inline_actions += counters[INLINE_ACTIONS];
+            p.deferred_sends += counters[DEFERRED_SENDS];
+        }
+    };
+
+#ifdef GYFTIE_PERFSTATS
+    typedef Stats<true> stats;
+#else
+    typedef Stats<false> stats;
+#endif
+}
+
+#endif
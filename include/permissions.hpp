@@ -8,6 +8,8 @@
 #include <eosio/eosio.hpp>
 #include <eosio/crypto.hpp>
 
+#include "base58.hpp"
+
 using namespace eosio;
 using std::set;
 using std::vector;
@@ -16,46 +18,6 @@ using std::string;
 namespace permissions
 {
 
-const char base58_chars[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
-
-bool map_initialized = false;
-std::array<int8_t, 256> base58_map{{0}};
-auto get_base58_map()
-{
-  if (!map_initialized)
-  {
-    for (unsigned i = 0; i < base58_map.size(); ++i)
-      base58_map[i] = -1;
-    for (unsigned i = 0; i < sizeof(base58_chars); ++i)
-      base58_map[base58_chars[i]] = i;
-    map_initialized = true;
-  }
-  return base58_map;
-}
-
-template <size_t size>
-std::array<uint8_t, size> base58_to_binary(std::string_view s)
-{
-  // print (" String in to_binary: ", s.data(), "\n");
-  std::array<uint8_t, size> result{{0}};
-  for (auto &src_digit : s)
-  {
-    int carry = get_base58_map()[src_digit];
-    // print (" Source digit: ", src_digit, "\n");
-    // print ( " Carry: ", std::to_string(carry), "\n");
-    eosio::check(carry >= 0, "invalid base-58 value");
-    for (auto &result_byte : result)
-    {
-      int x = result_byte * 58 + carry;
-      result_byte = x;
-      carry = x >> 8;
-    }
-    eosio::check(!carry, "base-58 value is out of range");
-  }
-  std::reverse(result.begin(), result.end());
-  return result;
-}
-
 enum class key_type : uint8_t
 {
   k1 = 0,
@@ -68,11 +30,30 @@ struct public_key
   std::array<uint8_t, 33> data{};
 };
 
-template <typename Key, int suffix_size>
-Key string_to_key(std::string_view s, key_type type, const char (&suffix)[suffix_size])
+// The last four bytes of an encoded key are the first four bytes of
+// ripemd160(key data + suffix); legacy "EOS" keys have no suffix.
+template <size_t size>
+void check_key_checksum(const std::array<uint8_t, size> &whole, std::string_view suffix)
+{
+  constexpr size_t key_size = size - 4;
+  std::array<char, key_size + 2> buffer;
+  eosio::check(suffix.size() <= 2, "invalid key suffix");
+
+  memcpy(buffer.data(), whole.data(), key_size);
+  memcpy(buffer.data() + key_size, suffix.data(), suffix.size());
+
+  auto digest = eosio::ripemd160(buffer.data(), key_size + suffix.size()).extract_as_byte_array();
+  eosio::check(memcmp(digest.data(), whole.data() + key_size, 4) == 0, "public key checksum does not match");
+}
+
+template <typename Key>
+Key string_to_key(std::string_view s, key_type type, std::string_view suffix)
 {
-  static const auto size = std::tuple_size<decltype(Key::data)>::value;
-  auto whole = base58_to_binary<size + 4>(s);
+  static constexpr auto size = std::tuple_size<decltype(Key::data)>::value;
+  std::array<uint8_t, size + 4> whole;
+  eosio::check(base58::decode(s, whole), "invalid base-58 public key");
+  check_key_checksum(whole, suffix);
+
   Key result{type};
   memcpy(result.data.data(), whole.data(), result.data.size());
   return result;
@@ -82,11 +63,11 @@ public_key string_to_public_key(std::string_view s)
 {
   if (s.size() >= 3 && s.substr(0, 3) == "EOS")
   {
-    auto whole = base58_to_binary<37>(s.substr(3));
-    public_key key{key_type::k1};
-    static_assert(whole.size() == key.data.size() + 4, "Error: whole.size() != key.data.size() + 4");
-    memcpy(key.data.data(), whole.data(), key.data.size());
-    return key;
+    return string_to_key<public_key>(s.substr(3), key_type::k1, "");
+  }
+  else if (s.size() >= 7 && s.substr(0, 7) == "PUB_K1_")
+  {
+    return string_to_key<public_key>(s.substr(7), key_type::k1, "K1");
   }
   else if (s.size() >= 7 && s.substr(0, 7) == "PUB_R1_")
   {
@@ -99,6 +80,13 @@ public_key string_to_public_key(std::string_view s)
   }
 }
 
+eosio::public_key to_eosio_public_key(const public_key &key)
+{
+  std::array<char, 33> key_char;
+  std::copy(key.data.begin(), key.data.end(), key_char.begin());
+  return eosio::public_key{(uint8_t)key.type, key_char};
+}
+
 struct key_weight
 {
   eosio::public_key key;
@@ -133,14 +121,8 @@ authority keystring_authority(string key_str)
   // Setup authority
   authority ret_authority;
 
-  // Array to hold public key
-  std::array<char, 33> key_char;
-
-  // Copy key to char array
-  std::copy(key.data.begin(), key.data.end(), key_char.begin());
-
   key_weight kweight{
-      .key = {(uint8_t)permissions::key_type::k1, key_char},
+      .key = permissions::to_eosio_public_key(key),
       .weight = (uint16_t)1};
 
   // Authority
@@ -8,6 +8,8 @@
 #include "badge.hpp"
 #include "common.hpp"
 #include "challenge.hpp"
+#include "perfstats.hpp"
+#include "trace.hpp"
 
 using namespace eosio;
 using namespace common;
@@ -29,6 +31,8 @@ class Permit {
         signatory_table s_t (contract, contract.value);
         auto s_itr = s_t.find (new_signatory.value);
         eosio::check (s_itr == s_t.end(), "Account is already a signatory.");
+        perf::stats::count (perf::ROWS_READ);
+        perf::stats::count (perf::ROWS_WRITTEN);
 
         return s_t.emplace (contract, [&](auto &s) {
             s.account = new_signatory;
@@ -40,6 +44,8 @@ class Permit {
         signatory_table s_t (contract, contract.value);
         auto s_itr = s_t.find (new_signatory.value);
         eosio::check (s_itr != s_t.end(), "Signatory not found.");
+        perf::stats::count (perf::ROWS_READ);
+        perf::stats::count (perf::ROWS_WRITTEN);
 
         return s_t.erase (s_itr);
     }
@@ -55,26 +61,31 @@ class Permit {
 
             ProfileClass profileClass (contract);
             
-            eosio::check (!profileClass.existsInV1 (account), "Account " + account.to_string() + " must upgrade profile.");
-            eosio::check (profileClass.existsInV2 (account), "Account " + account.to_string() + " does not have a profile.");
+            common::lazy_check (!profileClass.existsInV1 (account), "Account ", account, " must upgrade profile.");
+            common::lazy_check (profileClass.existsInV2 (account), "Account ", account, " does not have a profile.");
 
             if (receiver.value != 0) {
-                eosio::check (!profileClass.existsInV1 (receiver), "Receiver account " + receiver.to_string() + " must upgrade profile.");
-                eosio::check (profileClass.existsInV2 (receiver), "Receiver account " + receiver.to_string() + " does not have a profile.");
+                common::lazy_check (!profileClass.existsInV1 (receiver), "Receiver account ", receiver, " must upgrade profile.");
+                common::lazy_check (profileClass.existsInV2 (receiver),
+                    "Receiver account ", receiver, " does not have a profile.");
             }
 
             LockClass lockClass (contract);
+            perf::stats::count (perf::ROWS_READ);
             eosio::check (lockClass.lock_t.find(account.value) == lockClass.lock_t.end(), "Account is locked from performing activity.");
 
             GyftieClass gyftieClass (contract);
+            perf::stats::count (perf::ROWS_READ);
             eosio::check (gyftieClass.get_state().paused == UNPAUSED, "Contract is paused.");
             
             // Verify that the account is not being challenged
             ChallengeClass challengeClass (contract);
             auto c_itr = challengeClass.challenge_t.find (account.value);
-            check (c_itr == challengeClass.challenge_t.end(), "Account " + account.to_string() + " has an active challenge.");
+            perf::stats::count (perf::ROWS_READ);
+            common::lazy_check (c_itr == challengeClass.challenge_t.end(), "Account ", account, " has an active challenge.");
             c_itr = challengeClass.challenge_t.find (receiver.value);
-            check (c_itr == challengeClass.challenge_t.end(), "Receiver " + receiver.to_string() + " has an active challenge.");
+            perf::stats::count (perf::ROWS_READ);
+            common::lazy_check (c_itr == challengeClass.challenge_t.end(), "Receiver ", receiver, " has an active challenge.");
         }
     };
 
@@ -96,9 +107,10 @@ class Permit {
         static void permit (const name& contract, const name& gyftieAccount, const name& anyAccount) {
             Activity::permit (contract, gyftieAccount, gyftieAccount);
 
-            check (is_account(anyAccount), "Account is not a valid EOS account: " + anyAccount.to_string());
+            common::lazy_check (is_account(anyAccount), "Account is not a valid EOS account: ", anyAccount);
 
             GyftieClass gyftieClass (contract);
+            perf::stats::count (perf::ROWS_READ, 2);
             check (gyftieClass.get_state().gyftieoracle.value > 0, "Gyftie oracle is not set.");
 
             require_auth (gyftieClass.get_state().gyftieoracle);
@@ -122,7 +134,8 @@ class Permit {
             AuthActivity::permit (contract, account);
 
             BadgeClass badgeClass (contract);
-            check (badgeClass.is_badgeholder("identified"_n, account), "Account " + account.to_string() + " must be verified (with badge) to sell GFT.");
+            common::lazy_check (badgeClass.is_badgeholder("identified"_n, account),
+                "Account ", account, " must be verified (with badge) to sell GFT.");
         }
     };
 
@@ -141,6 +154,7 @@ class Permit {
             while (!signed_by_signatory && s_itr != signatory_t.end()) {
                 signed_by_signatory = has_auth (s_itr->account);
                 s_itr++;
+                perf::stats::count (perf::ROWS_READ);
             }
 
             eosio::check (signed_by_signatory, "Transaction requires the approval of the Gyftie account or a signatory.");
@@ -152,7 +166,6 @@ class Permit {
         public: 
 
         static void permit (const name& contract) {
-            print (" \n Signatory Activity \n");
             if (has_auth (contract)) {
                 return;
             }
@@ -164,8 +177,9 @@ class Permit {
             while (!signed_by_signatory && s_itr != signatory_t.end()) {
                 signed_by_signatory = has_auth (s_itr->account);
                 s_itr++;
+                perf::stats::count (perf::ROWS_READ);
             }
-            print (" Signed by signatory: ", std::to_string (signed_by_signatory), "\n");
+            TRACE_DEBUG ("signatory.permit", "contract", contract, "signed", signed_by_signatory);
             eosio::check (signed_by_signatory, "Transaction requires the approval of a signatory.");
         }
     };
@@ -173,9 +187,8 @@ class Permit {
     class LockActivity : SignatoryActivity {
         public:
         static void permit (const name& contract, const name& account) {
-            print ("\n Lock Activity \n");
+            TRACE_DEBUG ("lock.permit", "contract", contract, "account", account);
             // require_auth (contract);
-            print (" \nAfter require auth\n");
             SignatoryActivity::permit (contract);
 
             eosio::check (is_account (account), "Account is not a valid EOS account.");
@@ -192,21 +205,8 @@ class Permit {
         static void permit (const name& contract, const name& account, const name& receiver) {
             Activity::permit (contract, account, receiver);
             GyftClass gyftClass (contract);
-            auto gyfter_index = gyftClass.gyft_t.get_index<"bygyfter"_n>();
-            auto gyfter_itr = gyfter_index.find(account.value);
-
-            while (gyfter_itr != gyfter_index.end() && gyfter_itr->gyfter == account) {
-                eosio::check (gyfter_itr->gyftee != receiver, "Validator cannot validate an account they gyfted.");
-                gyfter_itr++;
-            }
-
-            auto gyftee_index = gyftClass.gyft_t.get_index<"bygyftee"_n>();
-            auto gyftee_itr = gyftee_index.find(account.value);
-
-            while (gyftee_itr != gyftee_index.end() && gyftee_itr->gyftee == account) {
-                eosio::check (gyftee_itr->gyfter != receiver, "Validator cannot validate their gyfter.");
-                gyftee_itr++;
-            }
+            eosio::check (!gyftClass.gyfted (account, receiver), "Validator cannot validate an account they gyfted.");
+            eosio::check (!gyftClass.gyfted (receiver, account), "Validator cannot validate their gyfter.");
         }
     };
     
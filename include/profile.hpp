@@ -5,9 +5,12 @@
 #include <eosio/eosio.hpp>
 #include <eosio/multi_index.hpp>
 #include <eosio/asset.hpp>
+#include <eosio/singleton.hpp>
 #include <algorithm>    // std::min
 
 #include "common.hpp"
+#include "perfstats.hpp"
+#include "trace.hpp"
 // #include "permit.hpp"
 
 using std::string;
@@ -90,15 +93,43 @@ class ProfileClass
       uint64_t      primary_key() const { return verify_id; }
       uint64_t      by_verifier() const { return verifier.value; }
       uint64_t      by_verified() const { return verified.value; }
+      uint128_t     by_verification() const { return (uint128_t{verifier.value} << 64) | verified.value; }
     };
 
     typedef eosio::multi_index<"verifies"_n, Verify, 
       indexed_by<"byverifier"_n,
         const_mem_fun<Verify, uint64_t, &Verify::by_verifier>>,
       indexed_by<"byverified"_n,
-        const_mem_fun<Verify, uint64_t, &Verify::by_verified>>
+        const_mem_fun<Verify, uint64_t, &Verify::by_verified>>,
+      indexed_by<"byverifypair"_n,
+        const_mem_fun<Verify, uint128_t, &Verify::by_verification>>
       > verify_table;
 
+    struct [[ eosio::table, eosio::contract("gyftietoken") ]] VerifyCount
+    {
+      name          account;
+      uint32_t      verified_by_count   = 0;
+      uint64_t      primary_key() const { return account.value; }
+    };
+
+    typedef eosio::multi_index<"verifycounts"_n, VerifyCount> verifycount_table;
+
+    static constexpr uint64_t NO_VERIFY = -1;
+
+    // verifies written before byverifypair and verifycounts existed are missing from both
+    // until the indexverifs migration has been through them; the cursor is the next verify
+    // to rewrite and how many rows of its verified account were rewritten before it
+    struct [[ eosio::table, eosio::contract("gyftietoken") ]] VerifyIndex
+    {
+      bool          pairs_indexed       = false;
+      name          next_verified;
+      uint64_t      next_verify_id      = NO_VERIFY;
+      uint32_t      account_rows        = 0;
+    };
+
+    typedef singleton<"verifyindex"_n, VerifyIndex> verifyindex_table;
+    typedef eosio::multi_index<"verifyindex"_n, VerifyIndex> verifyindex_table_placeholder;
+
     typedef eosio::multi_index<"profiles"_n, Profile> profile_table;
 
     struct [[ eosio::table, eosio::contract("gyftietoken") ]] Referral
@@ -117,22 +148,27 @@ class ProfileClass
     profile_table profile_t;
     profile2_table profile2_t;
     verify_table  verify_t;
+    verifycount_table verifycount_t;
+    verifyindex_table verifyindex_t;
     referral_table referral_t;
 
     ProfileClass (const name& contract) 
     : profile_t (contract, contract.value), 
       profile2_t (contract, contract.value),
       verify_t (contract, contract.value), 
+      verifycount_t (contract, contract.value),
+      verifyindex_t (contract, contract.value),
       referral_t (contract, contract.value),
       contract (contract) {}
 
     void create (const name& account) {
-      check (profile_t.find (account.value) == profile_t.end(), "Account " + 
-          account.to_string() + " already has a Gyftie profile - table 1.");
+      common::lazy_check (profile_t.find (account.value) == profile_t.end(),
+          "Account ", account, " already has a Gyftie profile - table 1.");
 
-      check (profile2_t.find (account.value) == profile2_t.end(), "Account " + 
-          account.to_string() + " already has a Gyftie profile - table 2.");
+      common::lazy_check (profile2_t.find (account.value) == profile2_t.end(),
+          "Account ", account, " already has a Gyftie profile - table 2.");
 
+      perf::stats::count (perf::ROWS_READ, 2);
       profile2_t.emplace (contract, [&](auto &p) {
           p.account = account;
           p.gft_balance = asset {0, common::S_GFT};
@@ -141,15 +177,17 @@ class ProfileClass
           p.updated_date = current_block_time().to_time_point();
           p.created_date = current_block_time().to_time_point();
       });         
+      perf::stats::count (perf::ROWS_WRITTEN);
     }
 
     void create (const name& account, const string& idhash, const string& id_expiration) {
-      check (profile_t.find (account.value) == profile_t.end(), "Account " + 
-          account.to_string() + " already has a Gyftie profile - table 1.");
+      common::lazy_check (profile_t.find (account.value) == profile_t.end(),
+          "Account ", account, " already has a Gyftie profile - table 1.");
 
-      check (profile2_t.find (account.value) == profile2_t.end(), "Account " + 
-          account.to_string() + " already has a Gyftie profile - table 2.");
+      common::lazy_check (profile2_t.find (account.value) == profile2_t.end(),
+          "Account ", account, " already has a Gyftie profile - table 2.");
 
+      perf::stats::count (perf::ROWS_READ, 2);
       profile2_t.emplace (contract, [&](auto &p) {
           p.account = account;
           p.idhash = idhash;
@@ -160,6 +198,7 @@ class ProfileClass
           p.updated_date = current_block_time().to_time_point();
           p.created_date = current_block_time().to_time_point();
       });         
+      perf::stats::count (perf::ROWS_WRITTEN);
     }
 
     void upgrade (const name& account) {
@@ -167,7 +206,8 @@ class ProfileClass
       // print ("Exists in V1: ", std::to_string(checker), "\n");
       if (existsInV1(account)) {
         auto p_itr = profile_t.find (account.value);
-        check (p_itr != profile_t.end(), "Upgrade failed. Profile for " + account.to_string() + " not found in profile - table 1.");
+        perf::stats::count (perf::ROWS_READ);
+        common::lazy_check (p_itr != profile_t.end(), "Upgrade failed. Profile for ", account, " not found in profile - table 1.");
 
         // print ("Adding " + account.to_string() + " to profile table 2.\n");
         profile2_t.emplace (contract, [&](auto &p) {
@@ -179,22 +219,27 @@ class ProfileClass
           p.staked_balance = p_itr->staked_balance;
           p.updated_date = current_block_time().to_time_point();
         });         
+        perf::stats::count (perf::ROWS_WRITTEN);
 
         // print ("Erasing record from profile table 1.");
         profile_t.erase (p_itr);
+        perf::stats::count (perf::ROWS_WRITTEN);
       }
     }
 
     void buying_gft (const name& account, const asset& amount) {
       if (existsInV2(account)) {
         auto p_itr = profile2_t.find (account.value);
+        perf::stats::count (perf::ROWS_READ);
         profile2_t.modify (p_itr, contract, [&](auto &p) {
           p.net_purchases += amount;
           p.updated_date = current_block_time().to_time_point();
         }); 
+        perf::stats::count (perf::ROWS_WRITTEN);
       }
 
       string memo = string ("Buying GFT: " + amount.to_string());
+      perf::stats::count (perf::INLINE_ACTIONS);
       action (
         permission_level{contract, "owner"_n},
         contract, "issueidemp"_n,
@@ -219,10 +264,12 @@ class ProfileClass
         //     p_itr->net_purchases.to_string() + "; Attempted selling amount: " + amount.to_string());
         // }
 
+        perf::stats::count (perf::ROWS_READ);
         profile2_t.modify (p_itr, contract, [&](auto &p) {
           p.net_purchases -= amount;
           p.updated_date = current_block_time().to_time_point();
         }); 
+        perf::stats::count (perf::ROWS_WRITTEN);
       }
     }
 
@@ -240,13 +287,15 @@ class ProfileClass
     }
 
     bool existsInV1 (const name& account) {
+      perf::stats::count (perf::ROWS_READ);
       return profile_t.find (account.value) != profile_t.end();
     }
 
     bool existsInV2 (const name& account) {
+      perf::stats::count (perf::ROWS_READ);
       auto p_itr = profile2_t.find (account.value);
       if (p_itr == profile2_t.end()) {
-        print (" User " + account.to_string() + " not found in profile table 2.");
+        TRACE_DEBUG ("profile.missing", "account", account, "table", "profiles2");
         return false;
       }
       return true;
@@ -257,34 +306,66 @@ class ProfileClass
     }
 
     void setidhash (const name& account, const string& idhash, const string& id_expiration) {
-
       if (existsInV2(account)) {
         auto p_itr = profile2_t.find (account.value);
+        perf::stats::count (perf::ROWS_READ);
         profile2_t.modify (p_itr, contract, [&](auto &p) {
           p.idhash = idhash;
           p.id_expiration = id_expiration;
           p.updated_date = current_block_time().to_time_point();
         }); 
+        perf::stats::count (perf::ROWS_WRITTEN);
       } else if (existsInV1(account)) {
         auto p_itr = profile_t.find (account.value);
+        perf::stats::count (perf::ROWS_READ);
         profile_t.modify (p_itr, contract, [&](auto &p) {
           p.idhash = idhash;
           p.id_expiration = id_expiration;
         }); 
+        perf::stats::count (perf::ROWS_WRITTEN);
       } else {
         check (false, "Cannot set idhash. Profile " + account.to_string() + " does not exist in either profile 1 or 2.");
       }
     }
   
-    void verifyuser (const name& verifier, const name& account_to_verify) {
+    bool has_verified (const name& verifier, const name& verified) {
+      if (verifyindex_t.get_or_default (VerifyIndex()).pairs_indexed) {
+        auto pair_index = verify_t.get_index<"byverifypair"_n>();
+        perf::stats::count (perf::INDEX_STEPS);
+        return pair_index.find ((uint128_t{verifier.value} << 64) | verified.value) != pair_index.end();
+      }
+
       auto verifier_index = verify_t.get_index<"byverifier"_n>();
       auto v_itr = verifier_index.find (verifier.value);
-      bool already_verified = false;
-      while (v_itr != verifier_index.end() && verifier == v_itr->verifier) {
-        check (v_itr->verified != account_to_verify, "Verifier has already verified user. Verifier: " +
-          verifier.to_string() + "; Account being verfied: " + account_to_verify.to_string());
-          v_itr++;
+      while (v_itr != verifier_index.end() && v_itr->verifier == verifier) {
+        perf::stats::count (perf::INDEX_STEPS);
+        if (v_itr->verified == verified) {
+          return true;
+        }
+        v_itr++;
+      }
+      return false;
+    }
+
+    void set_verified_count (const name& account, const uint32_t& count) {
+      auto vc_itr = verifycount_t.find (account.value);
+      perf::stats::count (perf::ROWS_READ);
+      if (vc_itr == verifycount_t.end()) {
+        verifycount_t.emplace (contract, [&](auto &vc) {
+          vc.account = account;
+          vc.verified_by_count = count;
+        });
+      } else {
+        verifycount_t.modify (vc_itr, contract, [&](auto &vc) {
+          vc.verified_by_count = count;
+        });
       }
+      perf::stats::count (perf::ROWS_WRITTEN);
+    }
+
+    void verifyuser (const name& verifier, const name& account_to_verify) {
+      common::lazy_check (!has_verified (verifier, account_to_verify),
+          "Verifier has already verified user. Verifier: ", verifier, "; Account being verfied: ", account_to_verify);
 
       verify_t.emplace (contract, [&](auto &v) {
         v.verify_id = verify_t.available_primary_key();
@@ -292,9 +373,42 @@ class ProfileClass
         v.verified = account_to_verify;
         v.verification_date = current_block_time().to_time_point().sec_since_epoch();
       });
+      perf::stats::count (perf::ROWS_WRITTEN);
+
+      auto vc_itr = verifycount_t.find (account_to_verify.value);
+      perf::stats::count (perf::ROWS_READ);
+      if (vc_itr == verifycount_t.end()) {
+        verifycount_t.emplace (contract, [&](auto &vc) {
+          vc.account = account_to_verify;
+          vc.verified_by_count = 1;
+        });
+      } else {
+        verifycount_t.modify (vc_itr, contract, [&](auto &vc) {
+          vc.verified_by_count++;
+        });
+      }
+      perf::stats::count (perf::ROWS_WRITTEN);
+    }
+
+    void decrement_verified_count (const name& account) {
+      auto vc_itr = verifycount_t.find (account.value);
+      perf::stats::count (perf::ROWS_READ);
+      if (vc_itr == verifycount_t.end()) {
+        return;
+      }
+
+      if (vc_itr->verified_by_count <= 1) {
+        verifycount_t.erase (vc_itr);
+      } else {
+        verifycount_t.modify (vc_itr, contract, [&](auto &vc) {
+          vc.verified_by_count--;
+        });
+      }
+      perf::stats::count (perf::ROWS_WRITTEN);
     }
 
     name get_referrer (const name& referred) {
+      perf::stats::count (perf::ROWS_READ);
       auto r_itr = referral_t.find (referred.value);
       if (r_itr == referral_t.end()) {
         return name{0};
@@ -306,40 +420,45 @@ class ProfileClass
 
     void referred (const name& referrer, const name& account_to_refer) {
       auto r_itr = referral_t.find (account_to_refer.value);
-      check (r_itr == referral_t.end(), "Account has already been referred: " + account_to_refer.to_string());
+      common::lazy_check (r_itr == referral_t.end(), "Account has already been referred: ", account_to_refer);
+      perf::stats::count (perf::ROWS_READ);
       
       referral_t.emplace (contract, [&](auto &r) {
         r.referred = account_to_refer;
         r.referrer = referrer;
       });
+      perf::stats::count (perf::ROWS_WRITTEN);
     }
 
     void accelunstake (const name& account) {
-     
       if (existsInV2(account)) {
         auto p_itr = profile2_t.find (account.value);
+        perf::stats::count (perf::ROWS_READ);
         profile2_t.modify (p_itr, contract, [&](auto &p) {
           p.gft_balance += p_itr->unstaking_balance + p_itr->staked_balance;
           p.unstaking_balance *= 0;
           p.staked_balance *= 0;
           p.updated_date = current_block_time().to_time_point();
         });
+        perf::stats::count (perf::ROWS_WRITTEN);
       } else if (existsInV1(account)) {
         auto p_itr = profile_t.find (account.value); 
+        perf::stats::count (perf::ROWS_READ);
         profile_t.modify (p_itr, contract, [&](auto &p) {
           p.gft_balance += p_itr->unstaking_balance + p_itr->staked_balance;
           p.unstaking_balance *= 0;
           p.staked_balance *= 0;
         });
+        perf::stats::count (perf::ROWS_WRITTEN);
       } else {
         check (false, "Cannot accelunstake. Profile " + account.to_string() + " does not exist in either profile 1 or 2.");
       }
     }
 
     void unstake (const name& account, const asset& quantity) {
-
       if (existsInV2(account)) {
         auto p_itr = profile2_t.find (account.value);
+        perf::stats::count (perf::ROWS_READ);
         check (p_itr->unstaking_balance >= quantity, "Unstaking balance is less than requested.");
         profile2_t.modify (p_itr, contract, [&](auto &p) {
           p.gft_balance += p_itr->unstaking_balance + p_itr->staked_balance;
@@ -347,36 +466,42 @@ class ProfileClass
           p.staked_balance *= 0;
           p.updated_date = current_block_time().to_time_point();
         });
+        perf::stats::count (perf::ROWS_WRITTEN);
       } else if (existsInV1(account)) {
         auto p_itr = profile_t.find (account.value); 
+        perf::stats::count (perf::ROWS_READ);
         check (p_itr->unstaking_balance >= quantity, "Unstaking balance is less than requested.");
         profile_t.modify (p_itr, contract, [&](auto &p) {
           p.gft_balance += p_itr->unstaking_balance + p_itr->staked_balance;
           p.unstaking_balance *= 0;
           p.staked_balance *= 0;
         });
+        perf::stats::count (perf::ROWS_WRITTEN);
       } else {
         check (false, "Cannot unstake. Profile " + account.to_string() + " does not exist in either profile 1 or 2.");
       }
     }
 
     void stake (const name& account, const asset& quantity) {
-      
       if (existsInV2(account)) {
         auto p_itr = profile2_t.find (account.value);
+        perf::stats::count (perf::ROWS_READ);
         check (p_itr->gft_balance >= quantity, "Liquid balance is less than quantity unstaking.");
         profile2_t.modify (p_itr, contract, [&](auto &p) {
           p.gft_balance -= quantity;
           p.staked_balance += quantity;
           p.updated_date = current_block_time().to_time_point();
         });
+        perf::stats::count (perf::ROWS_WRITTEN);
       } else if (existsInV1(account)) {
         auto p_itr = profile_t.find (account.value); 
+        perf::stats::count (perf::ROWS_READ);
         check (p_itr->gft_balance >= quantity, "Liquid balance is less than quantity unstaking.");
         profile_t.modify (p_itr, contract, [&](auto &p) {
           p.gft_balance -= quantity;
           p.staked_balance += quantity;
         });
+        perf::stats::count (perf::ROWS_WRITTEN);
       } else {
         check (false, "Cannot stake. Profile " + account.to_string() + " does not exist in either profile 1 or 2.");
       }
@@ -386,32 +511,50 @@ class ProfileClass
       if (existsInV1(account)) {
         auto p_itr = profile_t.require_find (account.value);
         profile_t.erase (p_itr);
+        perf::stats::count (perf::ROWS_WRITTEN);
       } else if (existsInV2(account)) {
         auto p_itr = profile2_t.require_find (account.value);
         profile2_t.erase (p_itr);
+        perf::stats::count (perf::ROWS_WRITTEN);
       }
 
       auto verified_index = verify_t.get_index<"byverified"_n>();
       auto v_itr = verified_index.lower_bound (account.value);
-      while (v_itr->verified == account && v_itr != verified_index.end()) {
+      while (v_itr != verified_index.end() && v_itr->verified == account) {
+        perf::stats::count (perf::INDEX_STEPS);
         v_itr = verified_index.erase (v_itr);
+        perf::stats::count (perf::ROWS_WRITTEN);
+      }
+
+      auto vc_itr = verifycount_t.find (account.value);
+      perf::stats::count (perf::ROWS_READ);
+      if (vc_itr != verifycount_t.end()) {
+        verifycount_t.erase (vc_itr);
+        perf::stats::count (perf::ROWS_WRITTEN);
       }
 
       auto verifier_index = verify_t.get_index<"byverifier"_n>();
       auto v_itr2 = verifier_index.lower_bound (account.value);
-      while (v_itr2->verifier == account && v_itr2 != verifier_index.end()) {
+      while (v_itr2 != verifier_index.end() && v_itr2->verifier == account) {
+        perf::stats::count (perf::INDEX_STEPS);
+        decrement_verified_count (v_itr2->verified);
         v_itr2 = verifier_index.erase (v_itr2);
+        perf::stats::count (perf::ROWS_WRITTEN);
       }
 
       auto r_itr = referral_t.find (account.value);
+      perf::stats::count (perf::ROWS_READ);
       if (r_itr != referral_t.end()) {
         referral_t.erase (r_itr);
+        perf::stats::count (perf::ROWS_WRITTEN);
       }
 
       auto referrer_index = referral_t.get_index<"byreferrer"_n>();
       auto r_itr2 = referrer_index.find (account.value);
       while (r_itr2->referrer == account && r_itr2 != referrer_index.end()) {
+        perf::stats::count (perf::INDEX_STEPS);
         r_itr2 = referrer_index.erase (r_itr2);
+        perf::stats::count (perf::ROWS_WRITTEN);
       } 
     }
 
@@ -425,32 +568,38 @@ class ProfileClass
       // Permit::permit (contract, voter, profile_to_promote, common::AUTH_ACTIVITY);
 
       auto voter_itr = profile2_t.find (voter.value);
-      check (voter_itr != profile2_t.end(), "Voting account does not have a profile: " + voter.to_string());
+      common::lazy_check (voter_itr != profile2_t.end(), "Voting account does not have a profile: ", voter);
 
       auto prof_to_promote_itr = profile2_t.find (profile_to_promote.value);
-      check (prof_to_promote_itr != profile2_t.end(), "Acount to promote does not have a profile: " + profile_to_promote.to_string());
+      common::lazy_check (prof_to_promote_itr != profile2_t.end(),
+          "Acount to promote does not have a profile: ", profile_to_promote);
     
+      perf::stats::count (perf::ROWS_READ, 2);
       profile2_t.modify (voter_itr, contract, [&](auto& p) {
         p.profiles_this_profile_voted_for.push_back (profile_to_promote);
         p.updated_date = current_block_time().to_time_point();
       });
+      perf::stats::count (perf::ROWS_WRITTEN);
 
       profile2_t.modify (prof_to_promote_itr, contract, [&](auto& p) {
         p.promotion_votes_for_this_profile.push_back (voter);
         p.updated_date = current_block_time().to_time_point();
       });
+      perf::stats::count (perf::ROWS_WRITTEN);
 
       promoteuser(profile_to_promote);
     }
 
     std::set<uint64_t> get_voting_ranks (const name& account) {
       auto p_itr = profile2_t.find (account.value);
+      perf::stats::count (perf::ROWS_READ);
       check (p_itr != profile2_t.end(), "Profile to promote is not found.");
 
       vector<name> votes = p_itr->promotion_votes_for_this_profile;
       std::set<uint64_t> rank_set;
       for (auto voter : votes) {
           rank_set.insert (profile2_t.get(voter.value).rank);
+          perf::stats::count (perf::ROWS_READ);
       }
       return rank_set;
     }
@@ -462,11 +611,13 @@ class ProfileClass
       // Permit::permit (contract, voter, profile_to_unpromote, common::AUTH_ACTIVITY);
 
       auto voter_itr = profile2_t.find (voter.value);
-      check (voter_itr != profile2_t.end(), "Voting account does not have a profile: " + voter.to_string());
+      common::lazy_check (voter_itr != profile2_t.end(), "Voting account does not have a profile: ", voter);
 
       auto prof_to_unpromote_itr = profile2_t.find (profile_to_unpromote.value);
-      check (prof_to_unpromote_itr != profile2_t.end(), "Account to un-promote does not have a profile: " + profile_to_unpromote.to_string());
+      common::lazy_check (prof_to_unpromote_itr != profile2_t.end(),
+          "Account to un-promote does not have a profile: ", profile_to_unpromote);
     
+      perf::stats::count (perf::ROWS_READ, 2);
       profile2_t.modify (voter_itr, contract, [&](auto& p) {
         p.profiles_this_profile_voted_for.erase (std::remove(p.profiles_this_profile_voted_for.begin(),
                                                              p.profiles_this_profile_voted_for.end(),
@@ -474,6 +625,7 @@ class ProfileClass
                                                   p.profiles_this_profile_voted_for.end());
         p.updated_date = current_block_time().to_time_point();
       });
+      perf::stats::count (perf::ROWS_WRITTEN);
 
       profile2_t.modify (prof_to_unpromote_itr, contract, [&](auto& p) {
         p.promotion_votes_for_this_profile.erase (std::remove(p.promotion_votes_for_this_profile.begin(),
@@ -482,6 +634,7 @@ class ProfileClass
                                                   p.promotion_votes_for_this_profile.end());
         p.updated_date = current_block_time().to_time_point();
       });
+      perf::stats::count (perf::ROWS_WRITTEN);
     }
 
     uint64_t get_next_strongest_rank (const uint64_t& rank) {
@@ -492,6 +645,7 @@ class ProfileClass
   
       auto rank_itr = rank_index.lower_bound(rank);
       rank_itr--;
+      perf::stats::count (perf::INDEX_STEPS, 2);
       check (rank_itr != rank_index.end(), "Profile with stronger rank not found.");
 
       return rank_itr->rank;
@@ -499,11 +653,13 @@ class ProfileClass
 
     uint64_t get_votes_from_rank (const name& account, const uint64_t& rank) {
       auto p_itr = profile2_t.find (account.value);
+      perf::stats::count (perf::ROWS_READ);
       check (p_itr != profile2_t.end(), "Profile to promote is not found.");
 
       uint64_t vote_count = 0;
       vector<name> votes = p_itr->promotion_votes_for_this_profile;
       for (auto voter : votes) {
+        perf::stats::count (perf::ROWS_READ);
         if (profile2_t.get(voter.value).rank == rank) {
           vote_count++;
         }
@@ -521,6 +677,7 @@ class ProfileClass
       while (rank_itr != rank_index.end() && rank_itr->rank == rank) {
         voter_count++;
         rank_itr++;
+        perf::stats::count (perf::INDEX_STEPS);
       }
 
       return voter_count;
@@ -529,12 +686,12 @@ class ProfileClass
     void promoteuser (const name account) {
 
       auto p_itr = profile2_t.find (account.value);
+      perf::stats::count (perf::ROWS_READ);
       eosio::check (p_itr != profile2_t.end(), "Profile to promote is not found.");
       eosio::check (p_itr->rank != 1, "User rank is at highest level; cannot be promoted.");
       eosio::check (p_itr->promotion_votes_for_this_profile.size() > 0, "There are no votes to promote this user.");
 
-      print (" Promoting user: ", account, "\n");
-      print (" Current rank: ", p_itr->rank, "\n");
+      TRACE_DEBUG ("promoteuser", "account", account, "rank", p_itr->rank);
       // bool promoted = false;
       
       std::set<uint64_t> potential_ranks = get_voting_ranks (account);
@@ -544,10 +701,8 @@ class ProfileClass
       while (potential_rank != potential_ranks.rend()) {
 
         rank_profile_count = get_rank_profile_count (*potential_rank);
-        print ("  Rank Profile Count: ", *potential_rank, ".......", rank_profile_count, "\n");
 
         votes_from_rank = get_votes_from_rank(account, *potential_rank);
-        print ("  Votes from Rank: ", *potential_rank, ".......", votes_from_rank, "\n");
 
         if (best_eligible_rank == 0) {
             best_eligible_rank = *potential_rank + rank_profile_count - votes_from_rank;
@@ -556,15 +711,17 @@ class ProfileClass
                                         (uint64_t) *potential_rank + rank_profile_count - votes_from_rank);
         }
 
-        print ("---- Best eligible rank ", std::to_string(best_eligible_rank), "\n");
+        TRACE_DEBUG ("promoteuser.rank", "rank", *potential_rank, "profiles", rank_profile_count,
+                     "votes", votes_from_rank, "best_eligible", best_eligible_rank);
         potential_rank++;
       }
 
       if (p_itr->rank == 0 || best_eligible_rank < p_itr->rank) {
-        print ("\n\n *** Promoting user: ", best_eligible_rank, "\n\n");
+        TRACE_INFO ("promoted", "account", account, "from", p_itr->rank, "to", best_eligible_rank);
         profile2_t.modify (p_itr, contract, [&](auto &p) {
           p.rank = best_eligible_rank;
         });
+        perf::stats::count (perf::ROWS_WRITTEN);
       } else { 
         eosio::check (false, "User does not have the votes to be promoted.");
       }
@@ -578,10 +735,12 @@ class ProfileClass
 
         auto p_itr = profile2_t.find (account.value);
         check (p_itr != profile2_t.end(), "Account to rank does not have a Gyftie profile.");
-        
+        perf::stats::count (perf::ROWS_READ);
+
         profile2_t.modify (p_itr, contract, [&](auto &p) {
             p.rank = rank;
         });
+        perf::stats::count (perf::ROWS_WRITTEN);
     }
 };
 
@@ -2,9 +2,12 @@
 #define PROPOSAL_H
 
 #include <eosio/eosio.hpp>
+#include <eosio/binary_extension.hpp>
 
 #include "permit.hpp"
 #include "profile.hpp"
+#include "blob.hpp"
+#include "trace.hpp"
 
 using std::vector;
 using std::string;
@@ -24,11 +27,12 @@ class ProposalClass {
             uint32_t                votes_for;
             vector<name>            voters_against;
             uint32_t                votes_against;
-            std::vector<char>       packed_transaction;
+            std::vector<char>       packed_transaction;     // legacy; new transactions are kept in the blob store
 
             time_point_sec          expiration_date         ;
             time_point_sec          created_date            = time_point_sec(current_time_point());
             time_point_sec          updated_date            = time_point_sec(current_time_point());
+            binary_extension<checksum256>   transaction_hash;
 
             uint64_t            primary_key () const { return proposal_id; }
             uint64_t            by_proposer () const { return proposer.value; }
@@ -72,10 +76,12 @@ class ProposalClass {
         name                contract;
         proposal_table      proposal_t;
         ProfileClass        profileClass;
+        BlobClass           blobClass;
            
         ProposalClass (const name& contract) : 
             proposal_t (contract, contract.value), 
             profileClass (contract),
+            blobClass (contract),
             contract (contract) {}
 
         void create (const name& proposer, const string& proposal_name, const string& notes) 
@@ -97,10 +103,13 @@ class ProposalClass {
         void remove (const uint64_t& proposal_id) 
         {
             auto p_itr = proposal_t.find (proposal_id);
-            eosio::check (p_itr != proposal_t.end(), "Proposal ID is not found: " + std::to_string(proposal_id));
+            common::lazy_check (p_itr != proposal_t.end(), "Proposal ID is not found: ", proposal_id);
 
             Permit::permit (contract, p_itr->proposer, name{0}, common::REMOVE_PROPOSAL);
 
+            if (p_itr->transaction_hash.has_value()) {
+                blobClass.release (p_itr->transaction_hash.value(), true);
+            }
             proposal_t.erase (p_itr);
         }
 
@@ -116,7 +125,7 @@ class ProposalClass {
                 prop.proposer           = proposer;
                 prop.notes              = notes;
                 prop.proposal_name      = proposal_name;
-                prop.packed_transaction = pkd_trx;
+                prop.transaction_hash   = blobClass.put (pkd_trx.data(), pkd_trx.size(), true);
             });
         }
 
@@ -130,8 +139,9 @@ class ProposalClass {
             //     "Proposal must be open for 24 hours before it can be executed");
 
             // Over 80% of voters approve
-            check (prop.votes_against * 4 <= prop.votes_for, "Proposal must have 80% positive votes to pass. Votes for: " +
-                std::to_string(prop.votes_for) + "; Votes against: " + std::to_string(prop.votes_against));
+            common::lazy_check (prop.votes_against * 4 <= prop.votes_for,
+                "Proposal must have 80% positive votes to pass. Votes for: ", prop.votes_for,
+                "; Votes against: ", prop.votes_against);
 
             // Over 60% of Tier 0 Signatories
             uint64_t rank_zero_votes_for = 0;
@@ -144,21 +154,30 @@ class ProposalClass {
             }
 
             uint64_t rank_zero_count = profileClass.get_rank_profile_count (0);
-            print (" Rank zero count: ", std::to_string(rank_zero_count), "\n");
+            TRACE_DEBUG ("proposal.rankzero", "votes_for", rank_zero_votes_for, "count", rank_zero_count);
             float rank_zero_voter_margin = (float) rank_zero_votes_for / (float) (rank_zero_count);
 
-            check (rank_zero_voter_margin >= 0.6000000000000, "Rank zero voter margin must be greater than 60% to pass. Rank zero votes for: " +
-                std::to_string(rank_zero_votes_for) + "; Rank zero voters: " + std::to_string(rank_zero_count));
+            common::lazy_check (rank_zero_voter_margin >= 0.6000000000000,
+                "Rank zero voter margin must be greater than 60% to pass. Rank zero votes for: ", rank_zero_votes_for,
+                "; Rank zero voters: ", rank_zero_count);
             
+            std::vector<char> packed_transaction = prop.packed_transaction;
+            if (prop.transaction_hash.has_value()) {
+                packed_transaction = blobClass.get (prop.transaction_hash.value());
+            }
+
             transaction_header trx_header;
-            datastream<const char*> ds( prop.packed_transaction.data(), prop.packed_transaction.size() );
+            datastream<const char*> ds( packed_transaction.data(), packed_transaction.size() );
             ds >> trx_header;
             check( trx_header.expiration >= eosio::time_point_sec(current_time_point()), "transaction expired" );
 
-            print (" Executing transaction for proposal  : ", prop.proposal_name, "\n");
+            TRACE_INFO ("proposal.execute", "proposal", prop.proposal_name, "executer", executer);
             send_deferred( current_block_time().to_time_point().sec_since_epoch() + prop.proposal_id, executer,
-                            prop.packed_transaction.data(), prop.packed_transaction.size() );
+                            packed_transaction.data(), packed_transaction.size() );
 
+            if (prop.transaction_hash.has_value()) {
+                blobClass.release (prop.transaction_hash.value(), true);
+            }
             proposal_t.erase(prop);
         }
 
@@ -178,7 +197,7 @@ class ProposalClass {
             Permit::permit (contract, voter, name{0}, common::AUTH_ACTIVITY);
             
             auto p_itr = proposal_t.find (proposal_id);
-            check (p_itr != proposal_t.end(), "Proposal ID does not exist: " + std::to_string(proposal_id));
+            common::lazy_check (p_itr != proposal_t.end(), "Proposal ID does not exist: ", proposal_id);
             check_vote (*p_itr, voter);
 
             proposal_t.modify (p_itr, contract, [&](auto &p) {
@@ -192,7 +211,7 @@ class ProposalClass {
             Permit::permit (contract, voter, name{0}, common::AUTH_ACTIVITY);
 
             auto p_itr = proposal_t.find (proposal_id);
-            check (p_itr != proposal_t.end(), "Proposal ID does not exist: " + std::to_string(proposal_id));
+            common::lazy_check (p_itr != proposal_t.end(), "Proposal ID does not exist: ", proposal_id);
             check_vote (*p_itr, voter);
             
             proposal_t.modify (p_itr, contract, [&](auto &p) {
@@ -206,7 +225,7 @@ class ProposalClass {
             Permit::permit (contract, voter, name{0}, common::AUTH_ACTIVITY);
            
             auto p_itr = proposal_t.find (proposal_id);
-            check (p_itr != proposal_t.end(), "Proposal ID does not exist: " + std::to_string(proposal_id));
+            common::lazy_check (p_itr != proposal_t.end(), "Proposal ID does not exist: ", proposal_id);
 
             bool voter_found = false;
 
@@ -228,8 +247,8 @@ class ProposalClass {
                 voter_found = true;
             }
 
-            eosio::check (voter_found, "Voter has not voted for or against this proposal. Voter: " + 
-                voter.to_string() + "; Proposal ID: " + std::to_string(proposal_id));
+            common::lazy_check (voter_found,
+                "Voter has not voted for or against this proposal. Voter: ", voter, "; Proposal ID: ", proposal_id);
         }
 
         uint64_t get_proposal_votes_from_rank (const Proposal& prop, const uint64_t& rank)
@@ -248,7 +267,7 @@ class ProposalClass {
         std::set<int> get_proposal_voting_ranks (const uint64_t proposal_id)
         {
             auto p_itr = proposal_t.find (proposal_id);
-            check (p_itr != proposal_t.end(), "Proposal to promote is not found: " + std::to_string(proposal_id));
+            common::lazy_check (p_itr != proposal_t.end(), "Proposal to promote is not found: ", proposal_id);
 
             vector<name> votes = p_itr->voters_for;
             std::set<int> rank_set;
@@ -276,7 +295,6 @@ class ProposalClass {
             while (potential_rank != potential_ranks.rend() && best_eligible_rank != 1) {
             
                 votes_from_rank = get_proposal_votes_from_rank(*p_itr, *potential_rank);
-                print (" -- Votes from rank: ", votes_from_rank, "\n");
 
                 if (best_eligible_rank == 0) {
                     best_eligible_rank = std::max(  *potential_rank - votes_from_rank, 1);
@@ -285,14 +303,14 @@ class ProposalClass {
                                                     *potential_rank - votes_from_rank), 1);
                 }
                 
-                print (" -- Best eligible rank: ", best_eligible_rank, "\n ");
+                TRACE_DEBUG ("promoteprop.rank", "rank", *potential_rank, "votes", votes_from_rank,
+                             "best_eligible", best_eligible_rank);
                 potential_rank++;
             }
 
-            print ("\nCurrent rank: ", p_itr->rank, "\n");
-
             if (p_itr->rank == 0 || best_eligible_rank < p_itr->rank) {
-                print ("\n\n *** Promoting proposal: ", best_eligible_rank, "\n\n");
+                TRACE_INFO ("promoted.proposal", "proposal", p_itr->proposal_name, "from", p_itr->rank,
+                            "to", best_eligible_rank);
                 proposal_t.modify (p_itr, contract, [&](auto &p) {
                     p.rank = best_eligible_rank;
                 });
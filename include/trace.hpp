@@ -0,0 +1,68 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <eosio/eosio.hpp>
+
+using namespace eosio;
+
+// Leveled traces. GYFTIE_TRACE_LEVEL picks the most verbose level compiled in:
+// 0 none (the default, for production), 1 error, 2 info, 3 debug. A trace is an event name
+// followed by key/value pairs and prints as one line:
+//
+//   TRACE_INFO ("deposit", "from", from, "quantity", quantity);
+//   [info] deposit from=alice quantity=1.0000 EOS
+//
+// Traces above the compiled level sit in a discarded 'if constexpr' branch, so neither the
+// print calls nor the argument expressions (to_string and the like) reach the WASM.
+#ifndef GYFTIE_TRACE_LEVEL
+#define GYFTIE_TRACE_LEVEL 0
+#endif
+
+namespace trace {
+
+    enum level : uint8_t {
+        NONE    = 0,
+        ERROR   = 1,
+        INFO    = 2,
+        DEBUG   = 3
+    };
+
+    constexpr uint8_t compiled_level = GYFTIE_TRACE_LEVEL;
+
+    constexpr bool enabled (const level l) {
+        return l != NONE && l <= compiled_level;
+    }
+
+    constexpr const char* tag (const level l) {
+        return l == ERROR ? "[error] " : l == INFO ? "[info] " : "[debug] ";
+    }
+
+    inline void fields () {}
+
+    template <typename Key, typename Value, typename... Rest>
+    void fields (const Key& key, const Value& value, const Rest&... rest) {
+        static_assert (sizeof...(Rest) % 2 == 0, "trace fields are key/value pairs");
+        print (" ", key, "=", value);
+        fields (rest...);
+    }
+
+    template <typename... Fields>
+    void emit (const level l, const char* event, const Fields&... f) {
+        print (tag (l), event);
+        fields (f...);
+        print ("\n");
+    }
+}
+
+#define GYFTIE_TRACE(LEVEL, ...)                                        \
+    do {                                                                \
+        if constexpr (::trace::enabled (LEVEL)) {                       \
+            ::trace::emit (LEVEL, __VA_ARGS__);                         \
+        }                                                               \
+    } while (0)
+
+#define TRACE_ERROR(...)    GYFTIE_TRACE (::trace::ERROR, __VA_ARGS__)
+#define TRACE_INFO(...)     GYFTIE_TRACE (::trace::INFO, __VA_ARGS__)
+#define TRACE_DEBUG(...)    GYFTIE_TRACE (::trace::DEBUG, __VA_ARGS__)
+
+#endif
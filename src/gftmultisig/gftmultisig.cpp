@@ -5,6 +5,10 @@ ACTION gftmultisig::addrequest (const name gyfter,
                                 const string owner_public_key,
                                 const string active_public_key)
 {
+    // decoding checks the prefix and checksum, so a bad key fails here rather than at account creation
+    permissions::string_to_public_key (owner_public_key);
+    permissions::string_to_public_key (active_public_key);
+
     gyftrequest_table g_t (get_self(), get_self().value);
     g_t.emplace (get_self(), [&](auto &g) {
         g.recipient = recipient;
@@ -24,18 +28,64 @@ ACTION gftmultisig::delrequest (const name recipient)
     g_t.erase (g_itr);
 }
 
-ACTION gftmultisig::clnrequests ()
+ACTION gftmultisig::clnrequests (const uint32_t max_rows)
 {
+    eosio::check (max_rows > 0, "max_rows must be greater than zero.");
+
     gyftrequest_table g_t (get_self(), get_self().value);
-    auto g_itr = g_t.begin();
-    
-    while (g_itr != g_t.end()) {
-        if ( is_account (g_itr->recipient)) {
-            g_itr = g_t.erase (g_itr);
+    cleancursor_table cc_t (get_self(), get_self().value);
+    cleancursor cursor = cc_t.get_or_default (cleancursor());
+
+    uint32_t now = current_block_time().to_time_point().sec_since_epoch();
+    auto requested_index = g_t.get_index<"byrequested"_n>();
+    auto g_itr = requested_index.lower_bound (cursor.request_cursor);
+
+    uint32_t rows = 0;
+    while (g_itr != requested_index.end() && rows < max_rows) {
+        if (g_itr->requested_date + REQUEST_TTL_SEC <= now || is_account (g_itr->recipient)) {
+            g_itr = requested_index.erase (g_itr);
         } else {
             g_itr++;
         }
+        rows++;
+    }
+
+    // wrap around once the end is reached so later calls pick up newly fulfilled requests
+    cursor.request_cursor = g_itr == requested_index.end() ? 0 : g_itr->by_requested();
+    cc_t.set (cursor, get_self());
+}
+
+ACTION gftmultisig::indexreqs (const uint32_t max_rows)
+{
+    require_auth (get_self());
+    eosio::check (max_rows > 0, "max_rows must be greater than zero.");
+
+    reqindex_table ri_t (get_self(), get_self().value);
+    reqindex progress = ri_t.get_or_default (reqindex());
+    eosio::check (!progress.requests_indexed, "Gyft requests are already indexed.");
+
+    // secondary index entries are only written with the row, so each request is erased and
+    // emplaced again unchanged; the row layout is the one older requests were written with,
+    // so the copy reads them exactly
+    gyftrequest_table g_t (get_self(), get_self().value);
+    auto g_itr = g_t.lower_bound (progress.next_recipient.value);
+
+    uint32_t rows = 0;
+    while (g_itr != g_t.end() && rows < max_rows) {
+        gyftrequest request = *g_itr;
+        g_itr = g_t.erase (g_itr);
+        g_t.emplace (get_self(), [&](auto &g) {
+            g = request;
+        });
+        rows++;
+    }
+
+    if (g_itr == g_t.end()) {
+        progress.requests_indexed = true;
+    } else {
+        progress.next_recipient = g_itr->recipient;
     }
+    ri_t.set (progress, get_self());
 }
 
 ACTION gftmultisig::remrequest (const name recipient)
@@ -82,16 +132,21 @@ ACTION gftmultisig::delproposal (const uint64_t proposal_id)
     p_t.erase (p_itr);
 }
 
-ACTION gftmultisig::clrproposals ()
+ACTION gftmultisig::clrproposals (const uint32_t max_rows)
 {
+    eosio::check (max_rows > 0, "max_rows must be greater than zero.");
+
     proposal_table p_t (get_self(), get_self().value);
     auto p_itr = p_t.begin();
     
-    while ( p_itr != p_t.end()) {
+    // erased rows are always at the front, so calling again resumes where this left off
+    uint32_t rows = 0;
+    while ( p_itr != p_t.end() && rows < max_rows) {
         eosio::check (  has_auth (get_self()) || 
                     has_auth(p_itr->proposer), "Permission to delete proposal denied.");
 
         p_itr = p_t.erase (p_itr);
+        rows++;
     }
 }
 
@@ -109,5 +164,5 @@ ACTION gftmultisig::approve(const uint64_t proposal_id)
     });
 }
 
-EOSIO_DISPATCH(gftmultisig, (addproposal)(approve)(delproposal)(remrequest)(clrproposals)(clnrequests)
+EOSIO_DISPATCH(gftmultisig, (addproposal)(approve)(delproposal)(remrequest)(clrproposals)(clnrequests)(indexreqs)
                             (addrequest)(delrequest))
\ No newline at end of file
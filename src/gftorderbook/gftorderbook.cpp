@@ -442,12 +442,147 @@ ACTION gftorderbook::limitbuygft (name buyer, asset price_per_gft, asset gft_amo
     eosio::check ( is_gyftie_account (buyer), "Buyer is not a gyftie account." );
     eosio::check (!is_paused(), "Contract is paused - no actions allowed.");
 
-    add_limitbuy_order (buyer, price_per_gft, gft_amount);
+    uint64_t order_id = add_limitbuy_order (buyer, price_per_gft, gft_amount);
 
+    begin_placed_order (order_id, true, price_per_gft, gft_amount);
     processbook ();
+    end_placed_orders (buyer);
 }
 
 
+// Places a batch of limit orders for one account: eligibility and the balance of each side are
+// checked once, the liquidity aggregates are written once and the book is matched in one pass.
+// If any of them fills, the new orders are reported in one orderresults, in the order given.
+ACTION gftorderbook::placeorders (name account, vector<OrderSpec> orders)
+{
+    require_auth (account);
+
+    eosio::check (!is_paused(), "Contract is paused - no actions allowed.");
+    eosio::check ( is_gyftie_account (account), "Account is not a gyftie account." );
+    common::lazy_check (orders.size() > 0 && orders.size() <= MAX_BATCH_ORDERS,
+        "A batch holds between 1 and ", MAX_BATCH_ORDERS, " orders.");
+
+    config_table config (get_self(), get_self().value);
+    auto c = config.get();
+    symbol gft_symbol = symbol{symbol_code(GYFTIE_SYM_STR.c_str()), GYFTIE_PRECISION};
+
+    asset buy_gft = asset {0, gft_symbol}, sell_gft = asset {0, gft_symbol};
+    asset buy_eos = asset {0, c.valid_counter_token_symbol}, sell_eos = asset {0, c.valid_counter_token_symbol};
+    uint16_t buy_count = 0, sell_count = 0;
+
+    for (const auto& o : orders) {
+        eosio::check (o.side == "buy"_n || o.side == "sell"_n, "Order side must be buy or sell.");
+        eosio::check (o.price_per_gft.symbol == c.valid_counter_token_symbol, "Price must be in the counter token symbol.");
+        eosio::check (o.gft_amount.symbol == gft_symbol, "Amount must be in GFT.");
+        eosio::check (o.price_per_gft.amount > 0, "Price must be greater than zero.");
+        eosio::check (o.gft_amount.amount > 0, "GFT amount must be greater than zero.");
+
+        asset order_value = get_eos_order_value (o.price_per_gft, o.gft_amount);
+        if (o.side == "buy"_n) {
+            buy_gft += o.gft_amount;
+            buy_eos += order_value;
+            buy_count++;
+        } else {
+            permit_selling (account, o.gft_amount);
+            sell_gft += o.gft_amount;
+            sell_eos += order_value;
+            sell_count++;
+        }
+    }
+
+    if (buy_count > 0) {
+        confirm_balance (account, buy_eos);
+    }
+    if (sell_count > 0) {
+        confirm_balance (account, sell_gft);
+    }
+    increase_liquidity (buy_gft, buy_eos, buy_count, sell_gft, sell_eos, sell_count);
+
+    placed_orders.reserve (orders.size());
+    for (const auto& o : orders) {
+        bool is_buy = o.side == "buy"_n;
+        uint64_t order_id = is_buy ? emplace_buy_order (account, o.price_per_gft, o.gft_amount)
+                                   : emplace_sell_order (account, o.price_per_gft, o.gft_amount);
+        begin_placed_order (order_id, is_buy, o.price_per_gft, o.gft_amount);
+    }
+
+    processbook ();
+    end_placed_orders (account);
+}
+
+// Changes the price and/or amount of an open order in place. No funds move: the open order
+// already reserves the account's balance, so only an increase in the reserved amount is checked
+// against the available balance, and the liquidity aggregates change by the deltas. Only the
+// byprice key changes on the row. A new price or a larger amount makes the order new for the
+// maker/taker split; if the new price crosses the book the order is matched like a new one and
+// its fills are reported in orderresults.
+ACTION gftorderbook::amendorder (name account, name side, uint64_t order_id,
+                                 asset price_per_gft, asset gft_amount)
+{
+    require_auth (account);
+    eosio::check (!is_paused(), "Contract is paused - no actions allowed.");
+    eosio::check (side == "buy"_n || side == "sell"_n, "Order side must be buy or sell.");
+    eosio::check (price_per_gft.amount > 0, "Price must be greater than zero.");
+    eosio::check (gft_amount.amount > 0, "GFT amount must be greater than zero.");
+
+    // rejects an order worth less than one unit of the counter token
+    asset order_value = get_eos_order_value (price_per_gft, gft_amount);
+    uint32_t now = current_block_time().to_time_point().sec_since_epoch();
+
+    if (side == "buy"_n) {
+        buyorder_table b_t (get_self(), get_self().value);
+        auto b_itr = b_t.find (order_id);
+        eosio::check (b_itr != b_t.end(), "Buy Order ID does not exist.");
+        eosio::check (b_itr->buyer == account, "Order belongs to another account.");
+        eosio::check (price_per_gft.symbol == b_itr->price_per_gft.symbol && gft_amount.symbol == b_itr->gft_amount.symbol,
+            "Amended order must keep the symbols of the order.");
+
+        asset value_change = order_value - b_itr->order_value;
+        if (value_change.amount > 0) {
+            confirm_balance (account, value_change);
+        }
+        increase_buygft_liquidity (gft_amount - b_itr->gft_amount, value_change, 0);
+
+        bool requeued = price_per_gft != b_itr->price_per_gft || gft_amount > b_itr->gft_amount;
+        b_t.modify (b_itr, get_self(), [&](auto &b) {
+            b.price_per_gft = price_per_gft;
+            b.gft_amount = gft_amount;
+            b.order_value = order_value;
+            if (requeued) {
+                b.created_date = now;
+            }
+        });
+    } else {
+        sellorder_table s_t (get_self(), get_self().value);
+        auto s_itr = s_t.find (order_id);
+        eosio::check (s_itr != s_t.end(), "Sell Order ID does not exist.");
+        eosio::check (s_itr->seller == account, "Order belongs to another account.");
+        eosio::check (price_per_gft.symbol == s_itr->price_per_gft.symbol && gft_amount.symbol == s_itr->gft_amount.symbol,
+            "Amended order must keep the symbols of the order.");
+
+        asset gft_change = gft_amount - s_itr->gft_amount;
+        if (gft_change.amount > 0) {
+            permit_selling (account, gft_change);
+            confirm_balance (account, gft_change);
+        }
+        increase_sellgft_liquidity (gft_change, order_value - s_itr->order_value, 0);
+
+        bool requeued = price_per_gft != s_itr->price_per_gft || gft_amount > s_itr->gft_amount;
+        s_t.modify (s_itr, get_self(), [&](auto &s) {
+            s.price_per_gft = price_per_gft;
+            s.gft_amount = gft_amount;
+            s.order_value = order_value;
+            if (requeued) {
+                s.created_date = now;
+            }
+        });
+    }
+
+    begin_placed_order (order_id, side == "buy"_n, price_per_gft, gft_amount);
+    processbook ();
+    end_placed_orders (account);
+}
+
 ACTION gftorderbook::stackbuyrec (name buyer, 
                                 asset orig_eos_amount, 
                                 asset cumulative_stacked_eos,
@@ -496,23 +631,7 @@ ACTION gftorderbook::stackbuy (name buyer, asset eos_amount)
     eosio::check ( is_gyftie_account (buyer), "Seller is not a gyftie account." );
 
     confirm_balance (buyer, eos_amount);    
-    asset price = asset {  std::max (get_lowest_sell().amount - 1, (int64_t) 1), eos_amount.symbol };
-    float share = 0.01000000;
-    asset order_eos =  adjust_asset(eos_amount, share);
-
-    eosio::transaction out{};
-    out.actions.emplace_back(permission_level{get_self(), "owner"_n}, 
-                            get_self(), "stackbuyrec"_n, 
-                            std::make_tuple(buyer,
-                                            eos_amount,
-                                            eos_amount * 0,
-                                            order_eos,
-                                            price,
-                                            1,
-                                            1));
-
-    out.delay_sec = 2;
-    out.send(get_next_sender_id(), get_self());
+    start_stackbuy (buyer, eos_amount);
 }
 
 ACTION gftorderbook::limitsellgft (name seller, asset price_per_gft, asset gft_amount)
@@ -529,9 +648,11 @@ ACTION gftorderbook::limitsellgft (name seller, asset price_per_gft, asset gft_a
     eosio::check ( is_gyftie_account (seller), "Seller is not a gyftie account." );
     eosio::check (!is_paused(), "Contract is paused - no actions allowed.");
 
-    add_limitsell_order (seller, price_per_gft, gft_amount);
-  
+    uint64_t order_id = add_limitsell_order (seller, price_per_gft, gft_amount);
+
+    begin_placed_order (order_id, false, price_per_gft, gft_amount);
     processbook ();
+    end_placed_orders (seller);
 }
 
 ACTION gftorderbook::stacksellrec (name seller, 
@@ -591,25 +712,7 @@ ACTION gftorderbook::stacksell (name seller, asset gft_amount)
     eosio::check ( is_gyftie_account (seller), "Seller is not a gyftie account." );
 
     confirm_balance (seller, gft_amount);
-    
-    asset price = get_highest_buy() + asset { 200, c.valid_counter_token_symbol};
-    float share = 0.01000000;
-
-    asset order_gft = adjust_asset(gft_amount, share);
-
-    eosio::transaction out{};
-    out.actions.emplace_back(permission_level{get_self(), "owner"_n}, 
-                            get_self(), "stacksellrec"_n, 
-                            std::make_tuple(seller,
-                                            gft_amount,
-                                            gft_amount * 0,
-                                            order_gft,
-                                            price,
-                                            1,
-                                            1));
-
-    out.delay_sec = 2;
-    out.send(get_next_sender_id(), get_self());
+    start_stacksell (seller, gft_amount, c);
 }
 
 ACTION gftorderbook::stack (name account, asset gft_amount, asset eos_amount)
@@ -627,6 +730,7 @@ ACTION gftorderbook::marketbuy (name buyer, asset eos_amount)
     // print (" Calling marketbuyr \n");
     marketbuyr (buyer, eos_amount);
     // print (" After marketbuyr \n");
+    send_trades ();
 
     // config_table config (get_self(), get_self().value);
     // auto c = config.get();
@@ -667,6 +771,7 @@ ACTION gftorderbook::marketsell (name seller, asset gft_amount)
     auto b_itr = b_index.rbegin();
 
     if (b_itr == b_index.rend()) {
+        send_trades ();
         return;
     }
 
@@ -677,6 +782,20 @@ ACTION gftorderbook::marketsell (name seller, asset gft_amount)
     if (remainder_to_sell.amount > 0) {
         marketsell (seller, remainder_to_sell);
     }    
+    send_trades ();
+}
+
+// Reports what marketbuy (an EOS quantity) or marketsell (a GFT quantity) would fill against
+// the current book in an inline quoteresult, without changing any table. Clients read the
+// quote from the quoteresult trace, e.g. of a transaction pushed without broadcasting it.
+ACTION gftorderbook::quote (asset quantity)
+{
+    perf::stats::count (perf::INLINE_ACTIONS);
+    action(
+        permission_level{get_self(), "owner"_n},
+        get_self(), "quoteresult"_n,
+        std::make_tuple(quantity, get_quote (quantity)))
+    .send();
 }
 
 ACTION gftorderbook::processbook () 
@@ -692,6 +811,7 @@ ACTION gftorderbook::processbook ()
 
     if (s_itr == s_index.end() || b_itr == b_index.rend()) {
         //buildbuckets_deferred();
+        send_trades ();
         return;
     }
 
@@ -699,6 +819,7 @@ ACTION gftorderbook::processbook ()
         match_order (s_itr->order_id, b_itr->order_id);
         processbook ();
     }
+    send_trades ();
 
   //  buildbuckets_deferred();
 }
@@ -708,6 +829,22 @@ ACTION gftorderbook::tradeexec (name buyer, name seller, name market_maker, asse
     require_auth (get_self());
 }
 
+// one per matching pass, so history indexers see every fill without an inline action per fill
+ACTION gftorderbook::tradesbatch ([[maybe_unused]] vector<Fill> fills)
+{
+    require_auth (get_self());
+}
+
+ACTION gftorderbook::quoteresult ([[maybe_unused]] asset quantity, [[maybe_unused]] Quote result)
+{
+    require_auth (get_self());
+}
+
+ACTION gftorderbook::orderresults ([[maybe_unused]] name account, [[maybe_unused]] vector<OrderResult> results)
+{
+    require_auth (get_self());
+}
+
 ACTION gftorderbook::reassign (name current, name newacct, asset quantity) 
 {
     require_auth (current);
@@ -908,24 +1045,33 @@ ACTION gftorderbook::transrec(name from, name to, asset quantity, string memo) {
             new_balance = quantity;
         });
 
-    print ("\n");
-    print(name{from}, " deposited:       ", quantity, "\n");
-    print(name{from}, " funds available: ", new_balance);
-    print ("\n");
+    TRACE_INFO ("deposit", "from", from, "quantity", quantity, "balance", new_balance);
+
+    place_from_memo (from, quantity, memo);
 }
 
 extern "C" {
     [[noreturn]] void apply(uint64_t receiver, uint64_t code, uint64_t action) {
-        if (action == "transfer"_n.value && code != receiver) {
+        if (code != receiver) {
+            // of the notifications, only incoming transfers are handled and counted
+            if (action != "transfer"_n.value) {
+                eosio_exit(0);
+            }
             eosio::execute_action(eosio::name(receiver), eosio::name(code), &gftorderbook::transrec);
         }
-        if (code == receiver) {
+        else {
             switch (action) { 
-                EOSIO_DISPATCH_HELPER(gftorderbook, (setconfig)(limitbuygft)(limitsellgft)(marketbuy)(marketsell)(stack)(stackbuy)(stacksell)(delsorders)(defbuckets)(delbordersv)(delsordersv)
-                                                    (removeorders)(processbook)(withdraw)(delconfig)(pause)(unpause)(tradeexec)(stacksellrec)(stackbuyrec)(compilestate)
+                EOSIO_DISPATCH_HELPER(gftorderbook, (setconfig)(limitbuygft)(limitsellgft)(placeorders)(amendorder)(marketbuy)(marketsell)(quote)(stack)(stackbuy)(stacksell)(delsorders)(defbuckets)(delbordersv)(delsordersv)
+                                                    (removeorders)(processbook)(withdraw)(delconfig)(pause)(unpause)(tradeexec)(tradesbatch)(quoteresult)(orderresults)(stacksellrec)(stackbuyrec)(compilestate)
                                                     (delbuyorder)(delsellorder)(admindelso)(admindelbo)(clearstate)(setstate)(reassign)(addliqreward)(payrewards)(upperm)
                                                     (setrewconfig)(addbucket)(buildbucket)(buildbuckets)(payliqinfrew)(payrewbucket)(payrewbucks))
-            }    
+                default:
+                    eosio_exit(0);
+            }
+        }
+        // quote writes no table, and perfstats builds keep it that way
+        if (action != "quote"_n.value && action != "quoteresult"_n.value) {
+            perf::stats::flush<gftorderbook> (eosio::name(receiver), eosio::name(action));
         }
         eosio_exit(0);
     }
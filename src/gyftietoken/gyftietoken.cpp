@@ -40,12 +40,12 @@ ACTION gyftietoken::addcomment (const name& commenter,
                                 profile, parent_id, comment_text);
 }
 
-ACTION gyftietoken::remcomment (const uint64_t& comment_id) {
-    commentClass.remove_comment (comment_id);
+ACTION gyftietoken::remcomment (const uint64_t& proposal_id, const name& profile, const uint64_t& comment_id) {
+    commentClass.remove_comment (proposal_id, profile, comment_id);
 }
 
-ACTION gyftietoken::editcomment (const uint64_t& comment_id, const string& comment_text) {
-    commentClass.edit_comment (comment_id, comment_text);
+ACTION gyftietoken::editcomment (const uint64_t& proposal_id, const name& profile, const uint64_t& comment_id, const string& comment_text) {
+    commentClass.edit_comment (proposal_id, profile, comment_id, comment_text);
 }
 
 ACTION gyftietoken::chgthrottle (const uint32_t throttle)
@@ -60,6 +60,51 @@ ACTION gyftietoken::xferzj ()
     // xfer_account ("zombiejigsaw"_n, "gftma.x"_n);
 }
 
+// run once with 0 after deploying byrelation; validation uses the index when this finishes
+ACTION gyftietoken::indexgyfts (const uint64_t start_gyft_id)
+{
+    require_auth (get_self());
+    gyftClass.reindex (start_gyft_id);
+}
+
+// Adds the stakes of challenges opened before challstakes existed to their challengers'
+// totals, 10 challenges per action. Run once with ""; counted challenges are skipped.
+ACTION gyftietoken::countchalls (const name start_challenged)
+{
+    require_auth (get_self());
+
+    uint32_t challenge_count = 0;
+    challenge_table c_t (get_self(), get_self().value);
+    auto c_itr = c_t.lower_bound (start_challenged.value);
+    while (c_itr != c_t.end() && challenge_count < 10) {
+        if (!c_itr->stake_counted.value_or (false)) {
+            add_challenge_stake (c_itr->challenger_account, c_itr->challenge_stake);
+            c_t.modify (c_itr, get_self(), [&](auto &c) {
+                c.stake_counted.emplace (true);
+            });
+        }
+        challenge_count++;
+        c_itr++;
+    }
+
+    if (c_itr != c_t.end()) {
+        eosio::transaction out{};
+        out.actions.emplace_back(permission_level{get_self(), "owner"_n}, 
+                                get_self(), "countchalls"_n, 
+                                std::make_tuple(c_itr->challenged_account));
+        out.delay_sec = 1;
+        out.send(get_next_sender_id(), get_self());
+    }
+}
+
+// run once after deploying byverifypair and verifycounts; both are used when it finishes
+ACTION gyftietoken::indexverifs (const uint32_t max_rows)
+{
+    require_auth (get_self());
+    eosio::check (max_rows > 0, "max_rows must be greater than zero.");
+    migration.indexverifs (max_rows);
+}
+
 // ACTION gyftietoken::remv2profs ()
 // {
 //     require_auth (get_self());
@@ -96,7 +141,7 @@ ACTION gyftietoken::createbadge (const name& badge_id,
                                     const name& issuer, 
                                     uint8_t badge_type) {
 
-    check (has_auth (get_self()) || has_auth ("gftma.x"_n), "Permission denied. Cannot create badge: " + badge_id.to_string());
+    common::lazy_check (has_auth (get_self()) || has_auth ("gftma.x"_n), "Permission denied. Cannot create badge: ", badge_id);
     
     badgeClass.add_badge (badge_id, badge_name, description, reward, profile_image, badge_image, mat_icon_name, issuer, badge_type);
 } 
@@ -141,6 +186,12 @@ ACTION gyftietoken::unlockchain (const name account_to_unlock, const string note
     LockChain::unlockchain (get_self(), account_to_unlock, note);
 }
 
+ACTION gyftietoken::chainnext (const name root, const uint32_t batch_size)
+{
+    Permit::permit (get_self(), root, name{0}, common::ANY_SIGNATORY);
+    LockChain::next (get_self(), root, batch_size);
+}
+
 ACTION gyftietoken::unlock (const name account_to_unlock, const string note) 
 {
     Permit::permit (get_self(), account_to_unlock, name{0}, common::LOCK_ACTIVITY);
@@ -149,7 +200,7 @@ ACTION gyftietoken::unlock (const name account_to_unlock, const string note)
 
 ACTION gyftietoken::addlock (const name account_to_lock, const string note) 
 {
-    print (" \n Adding a lock \n");
+    TRACE_INFO ("addlock", "account", account_to_lock, "note", note);
     // require_auth (get_self());
     Permit::permit (get_self(), account_to_lock, name{0}, common::LOCK_ACTIVITY);
     lockClass.lock (account_to_lock, note);
@@ -172,6 +223,8 @@ ACTION gyftietoken::dchallenge (const name challenged_account)
     auto c_itr = c_t.find (challenged_account.value);
     eosio::check (c_itr != c_t.end(), "Active challenge for account does not exist.");
 
+    sub_challenge_stake (*c_itr);
+    noteClass.remove_notes (challenged_account, "challenge"_n);
     c_t.erase (c_itr);
 }
 
@@ -182,6 +235,12 @@ ACTION gyftietoken::setconfig ( const name gftorderbook,
     gyftieClass.set_config (gftorderbook, gyftie_foundation, gyftieoracle);
 }
 
+ACTION gyftietoken::setblobmode (const uint8_t mode)
+{
+    require_auth (get_self());
+    blobClass.set_mode (mode);
+}
+
 ACTION gyftietoken::reset () 
 {
     require_auth (get_self());
@@ -239,9 +298,11 @@ ACTION gyftietoken::nchallenge (const name challenger_account, const name challe
         c.challenged_account = challenged_account;
         c.challenger_account = challenger_account;
         c.challenged_time = current_block_time().to_time_point().sec_since_epoch();
-        c.challenge_notes.push_back (note);
         c.challenge_stake = challenge_stake;
+        c.stake_counted.emplace (true);
     });
+    noteClass.add_note (challenged_account, "challenge"_n, note);
+    add_challenge_stake (challenger_account, challenge_stake);
 
      action (
         permission_level{get_self(), "owner"_n},
@@ -262,9 +323,7 @@ ACTION gyftietoken::addcnote (const name scribe, const name challenged_account,
     auto c_itr = c_t.find (challenged_account.value);
     eosio::check (c_itr != c_t.end(), "Account does not have an active challenge.");
 
-    c_t.modify (c_itr, get_self(), [&] (auto &c) {
-        c.challenge_notes.push_back (note);
-    });
+    noteClass.add_note (challenged_account, "challenge"_n, note);
 }
 
 ACTION gyftietoken::validate (const name validator, const name account, const string idhash, const string id_expiration)
@@ -283,6 +342,9 @@ ACTION gyftietoken::validate (const name validator, const name account, const st
     auto c_itr = c_t.find (account.value);
     eosio::check (c_itr != c_t.end(), "Account does not have an active challenge.");
 
+    // release the stake from the challenger's committed total before unstaking it
+    sub_challenge_stake (*c_itr);
+
     // DEPLOY
     requnstake (c_itr->challenger_account, c_itr->challenge_stake);
     //unstake (c_itr->challenger_account, c_itr->challenge_stake);
@@ -313,6 +375,7 @@ ACTION gyftietoken::validate (const name validator, const name account, const st
         std::make_tuple(c_itr->challenger_account, get_self(), redistribution_amount, redistribution_memo))
     .send();
 
+    noteClass.remove_notes (c_itr->challenged_account, "challenge"_n);
     c_t.erase (c_itr);    
 }
 
@@ -459,14 +522,14 @@ ACTION gyftietoken::removeprof (const name& account) {
     
     check (has_auth (get_self()) || has_auth ("gftma.x"_n), "Permission denied. Cannot prepare to remove profile.");
     auto p_itr = profileClass.profile_t.find (account.value);
-    check (p_itr != profileClass.profile_t.end(), "Gyftie profile not found in table 1: " + account.to_string());
+    common::lazy_check (p_itr != profileClass.profile_t.end(), "Gyftie profile not found in table 1: ", account);
 
     profileClass.removeprof (account);
 }
 
 ACTION gyftietoken::addhash (const name idchecker, const name idholder, const string idhash, const string id_expiration) {
 
-    print (" \nAdding hash : ", idhash, "\n\n");
+    TRACE_INFO ("addhash", "idchecker", idchecker, "idholder", idholder, "idhash", idhash);
     require_auth (idchecker);
     Permit::permit (get_self(), idchecker, idholder, common::GYFT);
 
@@ -651,8 +714,8 @@ ACTION gyftietoken::isstoskoracl (const name to, const asset quantity, const str
 {
     Permit::permit (get_self(), to, to, common::ORACLE_ACTIVITY);
 
-    check(quantity <= asset{1000000000, S_GFT}, "Permission denied. Insufficent authority to issue " + 
-            quantity.to_string() + " to stake."); 
+    common::lazy_check (quantity <= asset{1000000000, S_GFT},
+        "Permission denied. Insufficent authority to issue ", quantity, " to stake."); 
 
     action (
         permission_level{get_self(), "owner"_n},
@@ -694,15 +757,7 @@ ACTION gyftietoken::requnstake (const name user, const asset quantity)
     auto p_itr = profileClass.profile2_t.find (user.value);
     eosio::check (p_itr != profileClass.profile2_t.end(), "Account profile not found.");
 
-    challenge_table c_t (get_self(), get_self().value);
-    auto challenger_index = c_t.get_index<"bychallenger"_n>();
-    auto challenger_itr = challenger_index.begin();
-
-    asset challenged_balance = asset {0, quantity.symbol};
-    while (challenger_itr->challenger_account == user && challenger_itr != challenger_index.end()) {
-        challenged_balance += challenger_itr->challenge_stake;
-        challenger_itr++;
-    }
+    asset challenged_balance = get_challenge_stake (user);
 
     eosio::check (p_itr->staked_balance - p_itr->unstaking_balance >= quantity, "Requested unstake quantity exceeds staked balance.");
     eosio::check (p_itr->staked_balance - p_itr->unstaking_balance - challenged_balance >= quantity, "Requested unstake quantity exceeds staked balance when accounting for your active challenges.");
@@ -729,3 +784,22 @@ ACTION gyftietoken::requnstake (const name user, const asset quantity)
         p.staked_balance -= quantity;
     });
 }
+
+// Production builds use the dispatcher eosio-cpp generates from the ACTION declarations.
+// Perfstats builds need the action name after it has run, so they dispatch here instead.
+#ifdef GYFTIE_PERFSTATS
+extern "C" {
+    [[noreturn]] void apply(uint64_t receiver, uint64_t code, uint64_t action) {
+        if (code == receiver) {
+            switch (action) {
+                EOSIO_DISPATCH_HELPER(gyftietoken, GYFTIETOKEN_ACTIONS)
+                default:
+                    eosio_exit(0);
+            }
+            // only listed actions get here
+            perf::stats::flush<gyftietoken> (eosio::name(receiver), eosio::name(action));
+        }
+        eosio_exit(0);
+    }
+}
+#endif
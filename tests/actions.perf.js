@@ -0,0 +1,236 @@
+/* eslint-disable prettier/prettier */
+// Per-action resource suite. Boots a throwaway single-node chain, deploys gyftietoken,
+// gftorderbook, gftmultisig and the EOS token, seeds a realistic amount of state and pushes
+// each action PERF_RUNS times. Billed CPU, NET and RAM deltas are read from the transaction
+// receipts, written to PERF_REPORT and compared with PERF_BASELINE when that file exists.
+//
+//   npm run perf                                  run and compare with perf-baseline.json
+//   PERF_UPDATE_BASELINE=1 npm run perf           run and store the result as the new baseline
+//   PERF_NODEOS=external npm run perf             use a chain already listening on :8888
+//
+// Other knobs: PERF_PROFILES (2000), PERF_ORDERS (500), PERF_RUNS (20), PERF_CPU_TOLERANCE (0.25)
+
+const assert = require("assert");
+const fs = require("fs");
+const eoslime = require("../../eoslime").init("local");
+const chain = require("./chain");
+
+const NODEOS = process.env.PERF_NODEOS || "nodeos";
+const PROFILES = parseInt(process.env.PERF_PROFILES || "2000");
+const ORDERS = parseInt(process.env.PERF_ORDERS || "500");
+const RUNS = parseInt(process.env.PERF_RUNS || "20");
+const CPU_TOLERANCE = parseFloat(process.env.PERF_CPU_TOLERANCE || "0.25");
+const REPORT = process.env.PERF_REPORT || "perf-report.json";
+const BASELINE = process.env.PERF_BASELINE || "perf-baseline.json";
+
+// members[0..TRADERS) hold GFT and EOS in the order book
+const TRADERS = 100;
+
+let g;
+let members = [];
+let spares = [];
+let nodeos;
+
+const report = {};
+
+// RAM deltas are reported per action trace, including inline actions
+function ramDelta (traces) {
+  let bytes = 0;
+  for (const trace of traces || []) {
+    for (const delta of trace.account_ram_deltas || []) {
+      bytes += delta.delta;
+    }
+    bytes += ramDelta(trace.inline_traces);
+  }
+  return bytes;
+}
+
+function percentile (values, p) {
+  const sorted = values.slice().sort((a, b) => a - b);
+  return sorted[Math.min(sorted.length - 1, Math.floor(p * sorted.length))];
+}
+
+async function measure (action, runs, fn) {
+  const samples = [];
+  for (let i = 0; i < runs; i++) {
+    const result = await fn(i);
+    const receipt = result.processed.receipt;
+    samples.push({
+      cpu_us: receipt.cpu_usage_us,
+      net_bytes: receipt.net_usage_words * 8,
+      ram_bytes: ramDelta(result.processed.action_traces)
+    });
+  }
+
+  const cpu = samples.map((s) => s.cpu_us);
+  report[action] = {
+    runs: runs,
+    cpu_us_median: percentile(cpu, 0.5),
+    cpu_us_p90: percentile(cpu, 0.9),
+    cpu_us_max: Math.max(...cpu),
+    net_bytes_median: percentile(samples.map((s) => s.net_bytes), 0.5),
+    ram_bytes_median: percentile(samples.map((s) => s.ram_bytes), 0.5)
+  };
+  console.log("   ", action.padEnd(36), JSON.stringify(report[action]));
+}
+
+// NET and RAM are deterministic for a given action shape, so any increase is reported;
+// CPU is noisy on a local node and only the median is held to the tolerance.
+function compareWithBaseline (baseline) {
+  const regressions = [];
+  for (const action of Object.keys(baseline)) {
+    const base = baseline[action];
+    const current = report[action];
+    if (current === undefined) {
+      console.log("    missing from this run: ", action);
+      continue;
+    }
+    if (current.cpu_us_median > base.cpu_us_median * (1 + CPU_TOLERANCE)) {
+      regressions.push(action + ": cpu " + base.cpu_us_median + " -> " + current.cpu_us_median + " us");
+    }
+    if (current.net_bytes_median > base.net_bytes_median) {
+      regressions.push(action + ": net " + base.net_bytes_median + " -> " + current.net_bytes_median + " bytes");
+    }
+    if (current.ram_bytes_median > base.ram_bytes_median) {
+      regressions.push(action + ": ram " + base.ram_bytes_median + " -> " + current.ram_bytes_median + " bytes");
+    }
+  }
+  return regressions;
+}
+
+describe("Gyftie Action Resources", function() {
+  this.timeout(0);
+
+  before(async () => {
+    // traders, voters, vote candidates and locked accounts are disjoint slices of the members
+    assert.ok(PROFILES >= 300 + RUNS, "PERF_PROFILES must be at least 300 + PERF_RUNS");
+    assert.ok(RUNS <= 99, "PERF_RUNS must be below 100");
+
+    nodeos = await chain.startNodeos(NODEOS);
+    g = await chain.deployGyftie(eoslime);
+
+    console.log(" Seeding", PROFILES, "profiles");
+    members = await chain.seedTraders(eoslime, g, TRADERS);
+    const others = await chain.createAccounts(eoslime, PROFILES - TRADERS);
+    for (const member of others) {
+      await g.gyftieTokenContract.createprof(member.name, { from: g.gyftieOracle });
+    }
+    members = members.concat(others);
+    spares = await chain.createAccounts(eoslime, RUNS);
+
+    const traders = members.slice(0, TRADERS);
+    console.log(" Seeding", ORDERS, "resting orders on each side");
+    for (let i = 0; i < ORDERS; i++) {
+      const trader = traders[i % traders.length];
+      const cents = String(i % 100).padStart(2, "0");
+      await g.gftOrderBookContract.limitbuygft(trader.name, "4." + cents + "00 EOS", "0.10000000 GFT", { from: trader });
+      await g.gftOrderBookContract.limitsellgft(trader.name, "6." + cents + "00 EOS", "0.10000000 GFT", { from: trader });
+    }
+
+    await g.gyftieTokenContract.createbadge("perfbadge", "Perf Badge", "Badge used by the perf suite", "0.00000000 GFT", "", "", "star", g.gyftieOracle.name, 0, { from: g.gyftieTokenAccount });
+    console.log(" Completed perf setup");
+  });
+
+  after(async () => {
+    fs.writeFileSync(REPORT, JSON.stringify(report, null, 2) + "\n");
+    console.log(" Wrote", REPORT);
+
+    chain.stopNodeos(nodeos);
+
+    if (process.env.PERF_UPDATE_BASELINE) {
+      fs.writeFileSync(BASELINE, JSON.stringify(report, null, 2) + "\n");
+      console.log(" Updated", BASELINE);
+      return;
+    }
+
+    if (!fs.existsSync(BASELINE)) {
+      console.log(" No baseline at", BASELINE, "- run with PERF_UPDATE_BASELINE=1 to record one");
+      return;
+    }
+
+    const regressions = compareWithBaseline(JSON.parse(fs.readFileSync(BASELINE)));
+    assert.deepEqual(regressions, [], "Resource regressions against " + BASELINE + ":\n  " + regressions.join("\n  "));
+  });
+
+  it("gyftietoken :::: profiles and badges", async () => {
+    await measure("gyftietoken::createprof", RUNS, (i) =>
+      g.gyftieTokenContract.createprof(spares[i].name, { from: g.gyftieOracle }));
+
+    await measure("gyftietoken::issuebadge", RUNS, (i) =>
+      g.gyftieTokenContract.issuebadge(members[members.length - 1 - i].name, "perfbadge", "perf", { from: g.gyftieOracle }));
+
+    await measure("gyftietoken::addcomment", RUNS, (i) =>
+      g.gyftieTokenContract.addcomment(members[i].name, "comment", "18446744073709551615", members[0].name, 0,
+        "Comment " + i + " from the perf suite", { from: members[i] }));
+
+    // unique voter ranks below the default keep each promotion valid
+    const votes = Math.min(RUNS, 40);
+    for (let i = 0; i < votes; i++) {
+      await g.gyftieTokenContract.setrank(members[100 + i].name, 2 + i, { from: g.gyftieTokenAccount });
+    }
+    await measure("gyftietoken::voteforuser", votes, (i) =>
+      g.gyftieTokenContract.voteforuser(members[100 + i].name, members[200 + i].name, { from: members[100 + i] }));
+  });
+
+  it("gyftietoken :::: transfers and locks", async () => {
+    await measure("gyftietoken::issue", RUNS, (i) =>
+      g.gyftieTokenContract.issue(members[i].name, "0.00000001 GFT", "perf", { from: g.gyftieTokenAccount }));
+
+    await measure("gyftietoken::transfer", RUNS, (i) =>
+      g.gyftieTokenContract.transfer(members[i].name, members[i + 1].name, "0.00000001 GFT", "perf", { from: members[i] }));
+
+    await measure("gyftietoken::addlock", RUNS, (i) =>
+      g.gyftieTokenContract.addlock(members[300 + i].name, "perf lock", { from: g.gyftieTokenAccount }));
+
+    await measure("gyftietoken::unlock", RUNS, (i) =>
+      g.gyftieTokenContract.unlock(members[300 + i].name, "perf unlock", { from: g.gyftieTokenAccount }));
+  });
+
+  it("gftorderbook :::: deposits, orders and upkeep", async () => {
+    const trader = members[0];
+
+    await measure("eosio.token::transfer -> transrec", RUNS, () =>
+      g.eosTokenContract.transfer(trader.name, g.gftOrderBookAccount.name, "1.0000 EOS", "perf", { from: trader }));
+
+    await measure("gftorderbook::limitbuygft (resting)", RUNS, (i) =>
+      g.gftOrderBookContract.limitbuygft(trader.name, "3." + String(i).padStart(2, "0") + "00 EOS", "0.10000000 GFT", { from: trader }));
+
+    // each crossing sell fills against the highest resting bid
+    await measure("gftorderbook::limitsellgft (fill)", RUNS, (i) =>
+      g.gftOrderBookContract.limitsellgft(members[1 + i % 99].name, "4.0000 EOS", "0.01000000 GFT", { from: members[1 + i % 99] }));
+
+    const ownOrders = await chain.getRows(g, g.gftOrderBookAccount.name, g.gftOrderBookAccount.name, "buyorders", {
+      index_position: 2,
+      key_type: "name",
+      lower_bound: trader.name,
+      upper_bound: trader.name
+    });
+    const cancellable = ownOrders.slice(-RUNS);
+    await measure("gftorderbook::delbuyorder", cancellable.length, (i) =>
+      g.gftOrderBookContract.delbuyorder(cancellable[i].order_id, { from: trader }));
+
+    await measure("gftorderbook::processbook", RUNS, () =>
+      g.gftOrderBookContract.processbook({ from: g.gftOrderBookAccount }));
+
+    await measure("gftorderbook::buildbucket", RUNS, () =>
+      g.gftOrderBookContract.buildbucket(0, { from: g.gftOrderBookAccount }));
+
+    await measure("gftorderbook::buildbuckets", RUNS, () =>
+      g.gftOrderBookContract.buildbuckets({ from: g.gftOrderBookAccount }));
+  });
+
+  it("gftmultisig :::: requests and proposals", async () => {
+    await measure("gftmultisig::addrequest", RUNS, (i) =>
+      g.gftMultisigContract.addrequest(members[i].name, "perfreq" + "abcdefghijklmnopqrstuvwxyz"[i % 26] + "12345"[Math.floor(i / 26) % 5],
+        members[i].publicKey, members[i].publicKey, { from: members[i] }));
+
+    await measure("gftmultisig::addproposal", RUNS, (i) =>
+      g.gftMultisigContract.addproposal(members[i].name, g.gyftieTokenAccount.name, "perf " + i, "Perf suite proposal", "", { from: members[i] }));
+
+    await measure("gftmultisig::clnrequests", RUNS, () =>
+      g.gftMultisigContract.clnrequests(10, { from: g.gftMultisigAccount }));
+
+    await measure("gftmultisig::clrproposals", RUNS, () =>
+      g.gftMultisigContract.clrproposals(1, { from: g.gftMultisigAccount }));
+  });
+});
@@ -0,0 +1,168 @@
+/* eslint-disable prettier/prettier */
+// Local chain helpers shared by the perf suite and the load simulator: boot a throwaway
+// nodeos, create accounts in batches and deploy the Gyftie contracts with a working config.
+
+const fs = require("fs");
+const http = require("http");
+const os = require("os");
+const path = require("path");
+const { spawn } = require("child_process");
+
+const GYFTIETOKEN_WASM = "../gyftie/gyftietoken/gyftietoken.wasm";
+const GYFTIETOKEN_ABI = "../gyftie/gyftietoken/gyftietoken.abi";
+const TOKEN_WASM = "../gyftie/token/token.wasm";
+const TOKEN_ABI = "../gyftie/token/token.abi";
+const GFTORDERBOOK_WASM = "../gyftie/gftorderbook/gftorderbook.wasm";
+const GFTORDERBOOK_ABI = "../gyftie/gftorderbook/gftorderbook.abi";
+const GFTMULTISIG_WASM = "../gyftie/gftmultisig/gftmultisig.wasm";
+const GFTMULTISIG_ABI = "../gyftie/gftmultisig/gftmultisig.abi";
+
+// accounts are created in batches so the node is not flooded with parallel requests
+const ACCOUNT_BATCH = 100;
+
+// Starts nodeos on :8888 with a fresh data directory, unless nodeosBin is "external".
+// Returns a handle for stopNodeos, or undefined when an external chain is used.
+async function startNodeos (nodeosBin) {
+  if (nodeosBin === "external") {
+    await waitForChain(30000);
+    return undefined;
+  }
+
+  const dataDir = fs.mkdtempSync(path.join(os.tmpdir(), "gyftie-chain-"));
+  const proc = spawn(nodeosBin, [
+    "-e", "-p", "eosio",
+    "--data-dir", dataDir,
+    "--config-dir", dataDir,
+    "--plugin", "eosio::producer_plugin",
+    "--plugin", "eosio::chain_api_plugin",
+    "--plugin", "eosio::http_plugin",
+    "--http-server-address", "127.0.0.1:8888",
+    "--http-validate-host=false",
+    "--access-control-allow-origin=*",
+    "--verbose-http-errors",
+    "--max-transaction-time=1000",
+    "--abi-serializer-max-time-ms=1000",
+    "--chain-state-db-size-mb=4096"
+  ], { stdio: "ignore" });
+
+  await waitForChain(30000);
+  return { proc, dataDir };
+}
+
+function stopNodeos (handle) {
+  if (handle !== undefined) {
+    handle.proc.kill("SIGINT");
+  }
+}
+
+function getInfo () {
+  return new Promise((resolve, reject) => {
+    http.get("http://127.0.0.1:8888/v1/chain/get_info", (res) => {
+      let body = "";
+      res.on("data", (chunk) => { body += chunk; });
+      res.on("end", () => {
+        res.statusCode === 200 ? resolve(JSON.parse(body)) : reject(new Error("status " + res.statusCode));
+      });
+    }).on("error", reject);
+  });
+}
+
+async function waitForChain (timeoutMs) {
+  const deadline = Date.now() + timeoutMs;
+  for (;;) {
+    try {
+      return await getInfo();
+    } catch (e) {
+      if (Date.now() > deadline) {
+        throw new Error("nodeos did not come up: " + e.message);
+      }
+      await new Promise((resolve) => setTimeout(resolve, 250));
+    }
+  }
+}
+
+async function createAccounts (eoslime, count) {
+  let accounts = [];
+  while (accounts.length < count) {
+    accounts = accounts.concat(await eoslime.Account.createRandoms(Math.min(ACCOUNT_BATCH, count - accounts.length)));
+  }
+  return accounts;
+}
+
+// Deploys gyftietoken, gftorderbook, gftmultisig and the EOS token to fresh accounts and
+// configures them the way the functional tests do. The contract accounts get profiles
+// because they hold and move GFT themselves.
+async function deployGyftie (eoslime) {
+  const accounts = await createAccounts(eoslime, 6);
+  const g = {
+    gyftieTokenAccount: accounts[0],
+    eosTokenAccount: accounts[1],
+    gftOrderBookAccount: accounts[2],
+    gftMultisigAccount: accounts[3],
+    gyftieOracle: accounts[4],
+    gyftiegyftie: accounts[5]
+  };
+
+  await g.gyftieTokenAccount.addPermission(g.gyftieTokenAccount.name, "active", g.gyftieTokenAccount.name, "eosio.code");
+  await g.gyftieTokenAccount.addPermission(g.gyftieTokenAccount.name, "owner", g.gyftieTokenAccount.name, "eosio.code");
+  await g.gftOrderBookAccount.addPermission(g.gftOrderBookAccount.name, "active", g.gftOrderBookAccount.name, "eosio.code");
+  await g.gftOrderBookAccount.addPermission(g.gftOrderBookAccount.name, "owner", g.gftOrderBookAccount.name, "eosio.code");
+
+  g.gyftieTokenContract = await eoslime.AccountDeployer.deploy(GYFTIETOKEN_WASM, GYFTIETOKEN_ABI, g.gyftieTokenAccount);
+  g.eosTokenContract = await eoslime.AccountDeployer.deploy(TOKEN_WASM, TOKEN_ABI, g.eosTokenAccount);
+  g.gftOrderBookContract = await eoslime.AccountDeployer.deploy(GFTORDERBOOK_WASM, GFTORDERBOOK_ABI, g.gftOrderBookAccount);
+  g.gftMultisigContract = await eoslime.AccountDeployer.deploy(GFTMULTISIG_WASM, GFTMULTISIG_ABI, g.gftMultisigAccount);
+
+  await g.gyftieTokenContract.setconfig(g.gftOrderBookAccount.name, g.gyftiegyftie.name, g.gyftieOracle.name, { from: g.gyftieTokenAccount });
+  await g.gyftieTokenContract.unpause({ from: g.gyftieTokenAccount });
+  await g.gyftieTokenContract.create({ from: g.gyftieTokenAccount });
+
+  await g.gftOrderBookContract.setconfig(g.gyftieTokenAccount.name, g.eosTokenAccount.name, "EOS", 4, { from: g.gftOrderBookAccount });
+  await g.gftOrderBookContract.unpause({ from: g.gftOrderBookAccount });
+  await g.gftOrderBookContract.setstate("5.0000 EOS", { from: g.gftOrderBookAccount });
+  await g.gftOrderBookContract.setrewconfig(750000, 250000, { from: g.gftOrderBookAccount });
+  await g.gftOrderBookContract.addbucket(0, 100000, { from: g.gftOrderBookAccount });
+  await g.gftOrderBookContract.addbucket(100001, 500000, { from: g.gftOrderBookAccount });
+  await g.gftOrderBookContract.addbucket(500001, 1000000, { from: g.gftOrderBookAccount });
+
+  await g.eosTokenContract.create(g.eosTokenAccount.name, "1000000000.0000 EOS", { from: g.eosTokenAccount });
+
+  await g.gyftieTokenContract.createprof(g.gyftieTokenAccount.name, { from: g.gyftieOracle });
+  await g.gyftieTokenContract.createprof(g.gftOrderBookAccount.name, { from: g.gyftieOracle });
+
+  return g;
+}
+
+// Creates profiled traders holding GFT and EOS, with part of each deposited in the order book.
+async function seedTraders (eoslime, g, count) {
+  const traders = await createAccounts(eoslime, count);
+  for (const trader of traders) {
+    await g.gyftieTokenContract.createprof(trader.name, { from: g.gyftieOracle });
+    await g.gyftieTokenContract.issue(trader.name, "100.00000000 GFT", "seed", { from: g.gyftieTokenAccount });
+    await g.eosTokenContract.issue(trader.name, "10000.0000 EOS", "seed", { from: g.eosTokenAccount });
+    await g.eosTokenContract.transfer(trader.name, g.gftOrderBookAccount.name, "5000.0000 EOS", "seed", { from: trader });
+    await g.gyftieTokenContract.transfer(trader.name, g.gftOrderBookAccount.name, "50.00000000 GFT", "seed", { from: trader });
+  }
+  return traders;
+}
+
+async function getRows (g, code, scope, table, options) {
+  const result = await g.gyftieTokenContract.provider.eos.getTableRows(Object.assign({
+    code: code,
+    scope: scope,
+    table: table,
+    limit: 1000,
+    json: true
+  }, options || {}));
+  return result.rows;
+}
+
+module.exports = {
+  startNodeos,
+  stopNodeos,
+  waitForChain,
+  createAccounts,
+  deployGyftie,
+  seedTraders,
+  getRows
+};
@@ -0,0 +1,79 @@
+/* eslint-disable prettier/prettier */
+// Functional tests for gftmultisig. Boots a throwaway single-node chain with the real
+// contracts and checks the gyft request actions.
+//
+//   npm run multisig                              run against a fresh nodeos
+//   MULTISIG_NODEOS=external npm run multisig     use a chain already listening on :8888
+
+const assert = require("assert");
+const eoslime = require("../../eoslime").init("local");
+const chain = require("./chain");
+
+const NODEOS = process.env.MULTISIG_NODEOS || "nodeos";
+
+let g;
+let members;
+let nodeos;
+
+async function expectAssert (promise, message) {
+  try {
+    await promise;
+  } catch (e) {
+    const text = String((e && (e.message || e.json && JSON.stringify(e.json))) || e);
+    assert.ok(text.includes(message), "expected '" + message + "', got: " + text.slice(0, 200));
+    return;
+  }
+  assert.fail("expected the action to fail with '" + message + "'");
+}
+
+function requests (options) {
+  return chain.getRows(g, g.gftMultisigAccount.name, g.gftMultisigAccount.name, "gyftrequests", options);
+}
+
+describe("GFT Multisig", function() {
+  this.timeout(0);
+
+  before(async () => {
+    nodeos = await chain.startNodeos(NODEOS);
+    g = await chain.deployGyftie(eoslime);
+    members = await chain.createAccounts(eoslime, 3);
+    console.log(" Completed multisig setup");
+  });
+
+  after(async () => {
+    chain.stopNodeos(nodeos);
+  });
+
+  it("TEST 1 :::: indexreqs should rewrite requests in the older layout unchanged", async () => {
+    // the keys are stored as the text the gyfter sent, which is how requests made before
+    // byrequested existed were written
+    const recipients = ["legacyreqaaa", "legacyreqbbb", "legacyreqccc"];
+    for (let i = 0; i < recipients.length; i++) {
+      await g.gftMultisigContract.addrequest(members[i].name, recipients[i], members[i].publicKey, members[i].publicKey, { from: members[i] });
+    }
+    const before = await requests();
+    assert.equal(before.length, 3);
+    assert.equal(before[0].owner_public_key, members[0].publicKey);
+
+    // two rows per call: the first call stops part way, the second reaches the end
+    await g.gftMultisigContract.indexreqs(2, { from: g.gftMultisigAccount });
+    let progress = (await chain.getRows(g, g.gftMultisigAccount.name, g.gftMultisigAccount.name, "reqindex"))[0];
+    assert.equal(progress.requests_indexed, 0);
+    assert.equal(progress.next_recipient, recipients[2]);
+
+    await g.gftMultisigContract.indexreqs(2, { from: g.gftMultisigAccount });
+    progress = (await chain.getRows(g, g.gftMultisigAccount.name, g.gftMultisigAccount.name, "reqindex"))[0];
+    assert.equal(progress.requests_indexed, 1);
+
+    assert.deepEqual(await requests(), before);
+    const byRequested = await requests({ index_position: 3, key_type: "i128" });
+    assert.deepEqual(byRequested.map((r) => r.recipient).sort(), recipients);
+
+    await expectAssert(g.gftMultisigContract.indexreqs(2, { from: g.gftMultisigAccount }),
+      "Gyft requests are already indexed.");
+  });
+
+  it("TEST 2 :::: indexreqs should only run as the contract", async () => {
+    await expectAssert(g.gftMultisigContract.indexreqs(2, { from: members[0] }), "missing authority");
+  });
+});
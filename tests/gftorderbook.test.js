@@ -0,0 +1,277 @@
+/* eslint-disable prettier/prettier */
+// Functional tests for gftorderbook. Boots a throwaway single-node chain with the real
+// contracts, seeds traders holding GFT and EOS in the book and checks the order actions.
+//
+//   npm run orderbook                             run against a fresh nodeos
+//   ORDERBOOK_NODEOS=external npm run orderbook   use a chain already listening on :8888
+
+const assert = require("assert");
+const eoslime = require("../../eoslime").init("local");
+const chain = require("./chain");
+
+const NODEOS = process.env.ORDERBOOK_NODEOS || "nodeos";
+
+let g;
+let traders;
+let nodeos;
+
+// data of every inline action with the given name, in execution order
+function inlineData (result, actionName) {
+  const found = [];
+  const walk = (traces) => {
+    for (const trace of traces || []) {
+      if (trace.act.name === actionName) {
+        found.push(trace.act.data);
+      }
+      walk(trace.inline_traces);
+    }
+  };
+  walk(result.processed.action_traces);
+  return found;
+}
+
+async function expectAssert (promise, message) {
+  try {
+    await promise;
+  } catch (e) {
+    const text = String((e && (e.message || e.json && JSON.stringify(e.json))) || e);
+    assert.ok(text.includes(message), "expected '" + message + "', got: " + text.slice(0, 200));
+    return;
+  }
+  assert.fail("expected the action to fail with '" + message + "'");
+}
+
+async function openOrders (table, owner) {
+  const rows = await chain.getRows(g, g.gftOrderBookAccount.name, g.gftOrderBookAccount.name, table);
+  return rows.filter((row) => (row.buyer || row.seller) === owner.name);
+}
+
+async function bookState () {
+  return (await chain.getRows(g, g.gftOrderBookAccount.name, g.gftOrderBookAccount.name, "states"))[0];
+}
+
+async function getBuyOrder (orderId) {
+  const rows = await chain.getRows(g, g.gftOrderBookAccount.name, g.gftOrderBookAccount.name, "buyorders",
+    { lower_bound: orderId, limit: 1 });
+  return rows.length > 0 && rows[0].order_id === orderId ? rows[0] : undefined;
+}
+
+// places a resting bid and returns its order id; an order that fills nothing is not reported
+// in orderresults, so the id is the trader's newest bid
+async function placeBid (trader, price, gft) {
+  const result = await g.gftOrderBookContract.limitbuygft(trader.name, price, gft, { from: trader });
+  assert.equal(inlineData(result, "orderresults").length, 0);
+  const bids = await openOrders("buyorders", trader);
+  return Math.max(...bids.map((b) => b.order_id));
+}
+
+// the trader's deposited funds in the book for one symbol, e.g. "EOS"
+async function bookBalance (trader, symbolCode) {
+  const rows = await chain.getRows(g, g.gftOrderBookAccount.name, trader.name, "balances");
+  const row = rows.find((r) => r.funds.endsWith(" " + symbolCode));
+  return row ? row.funds : undefined;
+}
+
+function deposit (trader, quantity, memo) {
+  return g.eosTokenContract.transfer(trader.name, g.gftOrderBookAccount.name, quantity, memo, { from: trader });
+}
+
+function order (side, price, gft) {
+  return { side: side, price_per_gft: price, gft_amount: gft };
+}
+
+describe("GFT Order Book", function() {
+  this.timeout(0);
+
+  before(async () => {
+    nodeos = await chain.startNodeos(NODEOS);
+    g = await chain.deployGyftie(eoslime);
+    traders = await chain.seedTraders(eoslime, g, 8);
+    console.log(" Completed order book setup");
+  });
+
+  after(async () => {
+    chain.stopNodeos(nodeos);
+  });
+
+  it("TEST 1 :::: placeorders should place and match a batch with both sides", async () => {
+    const maker = traders[0];
+    const taker = traders[1];
+    await g.gftOrderBookContract.limitbuygft(maker.name, "4.5000 EOS", "1.00000000 GFT", { from: maker });
+
+    const result = await g.gftOrderBookContract.placeorders(taker.name, [
+      order("buy", "4.0000 EOS", "1.00000000 GFT"),
+      order("sell", "6.0000 EOS", "1.00000000 GFT"),
+      order("sell", "4.5000 EOS", "0.50000000 GFT")
+    ], { from: taker });
+
+    const reports = inlineData(result, "orderresults");
+    assert.equal(reports.length, 1);
+    const results = reports[0].results;
+    assert.deepEqual(results.map((r) => r.side), ["buy", "sell", "sell"]);
+    assert.equal(results[0].remaining_gft, "1.00000000 GFT");
+    assert.equal(results[1].remaining_gft, "1.00000000 GFT");
+    assert.equal(results[2].filled_gft, "0.50000000 GFT");
+    assert.equal(results[2].remaining_gft, "0.00000000 GFT");
+
+    assert.equal((await openOrders("buyorders", taker)).length, 1);
+    assert.equal((await openOrders("sellorders", taker)).length, 1);
+  });
+
+  it("TEST 2 :::: placeorders should take up to 100 orders in a batch", async () => {
+    const trader = traders[2];
+    const batch = [];
+    for (let i = 0; i < 100; i++) {
+      batch.push(order("buy", "1.0000 EOS", "0.01000000 GFT"));
+    }
+
+    // none of them cross, so nothing is reported
+    const result = await g.gftOrderBookContract.placeorders(trader.name, batch, { from: trader });
+    assert.equal(inlineData(result, "orderresults").length, 0);
+
+    batch.push(order("buy", "1.0000 EOS", "0.01000000 GFT"));
+    await expectAssert(g.gftOrderBookContract.placeorders(trader.name, batch, { from: trader }),
+      "A batch holds between 1 and 100 orders.");
+    await expectAssert(g.gftOrderBookContract.placeorders(trader.name, [], { from: trader }),
+      "A batch holds between 1 and 100 orders.");
+    assert.equal((await openOrders("buyorders", trader)).length, 100);
+  });
+
+  it("TEST 3 :::: placeorders should check the balance against the summed orders", async () => {
+    // 5000 EOS deposited: either order fits on its own, the two together do not
+    const trader = traders[3];
+    await expectAssert(g.gftOrderBookContract.placeorders(trader.name, [
+      order("buy", "1.0000 EOS", "3000.00000000 GFT"),
+      order("buy", "1.0000 EOS", "3000.00000000 GFT")
+    ], { from: trader }), "Insufficient funds.");
+    assert.equal((await openOrders("buyorders", trader)).length, 0);
+  });
+
+  it("TEST 4 :::: amendorder should raise an order in place without moving funds", async () => {
+    const trader = traders[4];
+    const orderId = await placeBid(trader, "2.0000 EOS", "1.00000000 GFT");
+    const before = await bookState();
+
+    const result = await g.gftOrderBookContract.amendorder(trader.name, "buy", orderId, "2.0000 EOS", "2.00000000 GFT", { from: trader });
+    assert.equal(inlineData(result, "transfer").length, 0);
+
+    const amended = await getBuyOrder(orderId);
+    assert.equal(amended.gft_amount, "2.00000000 GFT");
+    assert.equal(amended.order_value, "4.0000 EOS");
+
+    const after = await bookState();
+    assert.equal(after.buy_order_count, before.buy_order_count);
+    assert.equal(parseFloat(after.buy_orderbook_size_gft) - parseFloat(before.buy_orderbook_size_gft), 1);
+    assert.equal(parseFloat(after.buy_orderbook_size_eos) - parseFloat(before.buy_orderbook_size_eos), 2);
+  });
+
+  it("TEST 5 :::: amendorder should lower the price and amount of an order", async () => {
+    const trader = traders[4];
+    const orderId = (await openOrders("buyorders", trader))[0].order_id;
+    const before = await bookState();
+
+    await g.gftOrderBookContract.amendorder(trader.name, "buy", orderId, "1.5000 EOS", "0.50000000 GFT", { from: trader });
+
+    const amended = await getBuyOrder(orderId);
+    assert.equal(amended.price_per_gft, "1.5000 EOS");
+    assert.equal(amended.gft_amount, "0.50000000 GFT");
+    assert.equal(amended.order_value, "0.7500 EOS");
+
+    const after = await bookState();
+    assert.equal((parseFloat(before.buy_orderbook_size_eos) - parseFloat(after.buy_orderbook_size_eos)).toFixed(4), "3.2500");
+  });
+
+  it("TEST 6 :::: amendorder should match an order whose new price crosses the book", async () => {
+    // the lowest ask is the 6.0000 EOS sell left by TEST 1
+    const trader = traders[4];
+    const orderId = (await openOrders("buyorders", trader))[0].order_id;
+
+    const result = await g.gftOrderBookContract.amendorder(trader.name, "buy", orderId, "6.0000 EOS", "0.50000000 GFT", { from: trader });
+
+    const report = inlineData(result, "orderresults")[0].results[0];
+    assert.equal(report.order_id, orderId);
+    assert.equal(report.filled_gft, "0.50000000 GFT");
+    assert.equal(report.remaining_gft, "0.00000000 GFT");
+    assert.equal(await getBuyOrder(orderId), undefined);
+    assert.equal(inlineData(result, "tradesbatch").length, 1);
+  });
+
+  it("TEST 7 :::: amendorder should only change the owner's orders and keep a value", async () => {
+    const owner = traders[4];
+    const other = traders[5];
+    const orderId = await placeBid(owner, "2.0000 EOS", "1.00000000 GFT");
+
+    await expectAssert(g.gftOrderBookContract.amendorder(other.name, "buy", orderId, "2.0000 EOS", "5.00000000 GFT", { from: other }),
+      "Order belongs to another account.");
+    await expectAssert(g.gftOrderBookContract.amendorder(owner.name, "buy", orderId, "0.0001 EOS", "0.00000001 GFT", { from: owner }),
+      "Order value is less than 0.0001 EOS.");
+
+    const unchanged = await getBuyOrder(orderId);
+    assert.equal(unchanged.gft_amount, "1.00000000 GFT");
+    assert.equal(unchanged.order_value, "2.0000 EOS");
+  });
+
+  it("TEST 8 :::: a limit memo buy should never cost more than the deposit", async () => {
+    // 2000 EOS at 0.3333 is 6000.600060006... GFT; the order takes the floor of that
+    const trader = traders[6];
+    const result = await deposit(trader, "2000.0000 EOS", "limit:0.3333");
+    assert.equal(inlineData(result, "orderresults").length, 0);
+
+    const bids = await openOrders("buyorders", trader);
+    assert.equal(bids.length, 1);
+    assert.equal(bids[0].price_per_gft, "0.3333 EOS");
+    assert.equal(bids[0].gft_amount, "6000.60006000 GFT");
+    assert.equal(bids[0].order_value, "1999.9999 EOS");
+  });
+
+  it("TEST 9 :::: a limit memo with a bad or empty price should be rejected", async () => {
+    const trader = traders[7];
+    const before = await bookBalance(trader, "EOS");
+
+    await expectAssert(deposit(trader, "1.0000 EOS", "limit:"), "Price must be greater than zero.");
+    await expectAssert(deposit(trader, "1.0000 EOS", "limit:abc"), "Memo price is not a valid amount.");
+    await expectAssert(deposit(trader, "1.0000 EOS", "limit:1.00001"), "Memo price has too many decimal places.");
+    await expectAssert(deposit(trader, "1.0000 EOS", "limit:1.0000 GFT"), "Memo price must be in the counter token symbol.");
+
+    assert.equal(await bookBalance(trader, "EOS"), before);
+    assert.equal((await openOrders("buyorders", trader)).length, 0);
+  });
+
+  it("TEST 10 :::: a market memo should buy from the lowest ask", async () => {
+    // the only ask left is 0.5 GFT of the 6.0000 EOS sell from TEST 1
+    const trader = traders[7];
+    const result = await deposit(trader, "3.0000 EOS", "market");
+
+    assert.equal((await openOrders("sellorders", traders[1])).length, 0);
+    assert.equal(inlineData(result, "tradesbatch").length, 1);
+  });
+
+  it("TEST 11 :::: a limit memo that crosses should report its fills like limitsellgft", async () => {
+    // the highest bid is the 4.0000 EOS buy left by TEST 1
+    const trader = traders[7];
+    const result = await g.gyftieTokenContract.transfer(trader.name, g.gftOrderBookAccount.name, "0.50000000 GFT", "limit:4.0000", { from: trader });
+
+    const reports = inlineData(result, "orderresults");
+    assert.equal(reports.length, 1);
+    assert.equal(reports[0].account, trader.name);
+    assert.equal(reports[0].results[0].side, "sell");
+    assert.equal(reports[0].results[0].filled_gft, "0.50000000 GFT");
+    assert.equal(reports[0].results[0].remaining_gft, "0.00000000 GFT");
+  });
+
+  it("TEST 12 :::: unknown and ladder memos should credit the deposit", async () => {
+    const trader = traders[7];
+
+    // any other memo is a plain deposit and places nothing
+    let before = parseFloat(await bookBalance(trader, "EOS"));
+    await deposit(trader, "1.0000 EOS", "top up");
+    assert.equal((parseFloat(await bookBalance(trader, "EOS")) - before).toFixed(4), "1.0000");
+    assert.equal((await openOrders("buyorders", trader)).length, 0);
+
+    // ladder places its orders from a deferred action, so this runs last; the deposit is
+    // credited at once
+    before = parseFloat(await bookBalance(trader, "EOS"));
+    await deposit(trader, "10.0000 EOS", "ladder");
+    assert.equal((parseFloat(await bookBalance(trader, "EOS")) - before).toFixed(4), "10.0000");
+  });
+});
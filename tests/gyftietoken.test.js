@@ -529,4 +529,37 @@ describe("Gyftie Testing", function() {
     
   });
 
+  it('TEST 13 :::: Should count verifications per verified account', async () => {
+
+    // fresh accounts, so the count does not depend on the verifications made by earlier tests
+    const [verifier1, verifier2, verified] = await eoslime.Account.createRandoms(3);
+
+    await gyftieTokenContract.verifyuser (verifier1.name, verified.name, { from: verifier1 });
+    await gyftieTokenContract.verifyuser (verifier2.name, verified.name, { from: verifier2 });
+
+    let duplicateRejected = false;
+    try {
+      await gyftieTokenContract.verifyuser (verifier1.name, verified.name, { from: verifier1 });
+    } catch (e) {
+      duplicateRejected = true;
+    }
+    assert.ok (duplicateRejected);
+
+    // the migration sets counts from the verifies rows, so running it again changes nothing
+    await gyftieTokenContract.indexverifs (10, { from: gyftieTokenAccount });
+
+    const verifycounts = await gyftieTokenContract.provider.eos.getTableRows({
+      code: gyftieTokenAccount.name,
+      scope: gyftieTokenAccount.name,
+      table: "verifycounts",
+      lower_bound: verified.name,
+      limit: 1,
+      json: true
+    });
+    console.log(verifycounts);
+
+    assert.equal (verifycounts.rows[0].account, verified.name);
+    assert.equal (verifycounts.rows[0].verified_by_count, 2);
+  });
+
 });
@@ -0,0 +1,340 @@
+/* eslint-disable prettier/prettier */
+// Sustained-load simulator for gftorderbook. Boots a throwaway single-node chain with the
+// real contracts, then drives it with synthetic traders for LOAD_DURATION_SEC:
+//
+//   makers   place non-crossing limit orders around the mid price and cancel their own
+//   takers   cross the book with marketbuy and crossing limitsellgft orders
+//   upkeep   every LOAD_UPKEEP_SEC runs stackbuy, stacksell, buildbuckets and payliqinfrew
+//
+// Orders arrive open-loop (Poisson at LOAD_RATE orders/sec) so a slow chain shows up as
+// latency and failures rather than as a lower offered rate. With LOAD_RAMP set, the rate
+// starts at LOAD_RATE and rises by LOAD_RAMP every LOAD_STEP_SEC until more than
+// LOAD_MAX_CPU_FAILURES of a step fails on CPU; the last rate under that bound is reported
+// as the sustained rate.
+//
+//   npm run load                                  fixed rate against a fresh nodeos
+//   LOAD_RATE=5 LOAD_RAMP=5 npm run load          ramp 5, 10, 15 ... orders/sec
+//   LOAD_NODEOS=external npm run load             use a chain already listening on :8888
+//
+// Other knobs: LOAD_MAKERS (20), LOAD_TAKERS (20), LOAD_DURATION_SEC (120), LOAD_STEP_SEC (30),
+// LOAD_SAMPLE_SEC (5), LOAD_MAX_INFLIGHT (200), LOAD_REPORT (load-report.json)
+
+const fs = require("fs");
+const eoslime = require("../../eoslime").init("local");
+const chain = require("./chain");
+
+const NODEOS = process.env.LOAD_NODEOS || "nodeos";
+const MAKERS = parseInt(process.env.LOAD_MAKERS || "20");
+const TAKERS = parseInt(process.env.LOAD_TAKERS || "20");
+const DURATION_SEC = parseInt(process.env.LOAD_DURATION_SEC || "120");
+const RATE = parseFloat(process.env.LOAD_RATE || "10");
+const RAMP = parseFloat(process.env.LOAD_RAMP || "0");
+const STEP_SEC = parseInt(process.env.LOAD_STEP_SEC || "30");
+const SAMPLE_SEC = parseInt(process.env.LOAD_SAMPLE_SEC || "5");
+const UPKEEP_SEC = parseInt(process.env.LOAD_UPKEEP_SEC || "10");
+const MAX_INFLIGHT = parseInt(process.env.LOAD_MAX_INFLIGHT || "200");
+const MAX_CPU_FAILURES = parseFloat(process.env.LOAD_MAX_CPU_FAILURES || "0.01");
+const REPORT = process.env.LOAD_REPORT || "load-report.json";
+
+// share of the offered load; the rest are taker orders
+const MAKER_PLACE = 0.55;
+const MAKER_CANCEL = 0.15;
+
+// the book is set up around 5.0000 EOS per GFT; makers quote within SPREAD_CENTS of it
+const MID_CENTS = 500;
+const SPREAD_CENTS = 50;
+
+const CPU_FAILURE = /deadline exceeded|tx_cpu_usage_exceeded|billed CPU time|leeway_deadline_exception|cpu usage/i;
+
+function sleep (ms) {
+  return new Promise((resolve) => setTimeout(resolve, ms));
+}
+
+function pick (list) {
+  return list[Math.floor(Math.random() * list.length)];
+}
+
+function eos (cents) {
+  return (cents / 100).toFixed(4) + " EOS";
+}
+
+function percentile (values, p) {
+  if (values.length === 0) {
+    return 0;
+  }
+  const sorted = values.slice().sort((a, b) => a - b);
+  return sorted[Math.min(sorted.length - 1, Math.floor(p * sorted.length))];
+}
+
+// eoslime rejects with the node's error JSON as the message; keep a short, stable reason
+function classify (error) {
+  const text = String((error && (error.message || error.json && JSON.stringify(error.json))) || error);
+  if (CPU_FAILURE.test(text)) {
+    return "cpu";
+  }
+  const assertion = text.match(/assertion failure with message: ([^"\\]+)/);
+  if (assertion) {
+    return assertion[1].trim();
+  }
+  return text.slice(0, 80);
+}
+
+// Counters for one sampling window; the totals use the same shape.
+function newWindow () {
+  return { sent: 0, ok: 0, failed: 0, cpu_failed: 0, dropped: 0, latencies: [], reasons: {}, ops: {} };
+}
+
+const totals = newWindow();
+let current = newWindow();
+let inFlight = 0;
+
+function record (window, op, latency, reason) {
+  window.ops[op] = window.ops[op] || { ok: 0, failed: 0 };
+  if (reason === undefined) {
+    window.ok++;
+    window.ops[op].ok++;
+    window.latencies.push(latency);
+    return;
+  }
+  window.failed++;
+  window.ops[op].failed++;
+  window.reasons[reason] = (window.reasons[reason] || 0) + 1;
+  if (reason === "cpu") {
+    window.cpu_failed++;
+  }
+}
+
+// Pushes one transaction without waiting for it; the result lands in whichever window is
+// open when the node answers.
+function submit (op, fn) {
+  if (inFlight >= MAX_INFLIGHT) {
+    current.dropped++;
+    totals.dropped++;
+    return;
+  }
+  inFlight++;
+  current.sent++;
+  totals.sent++;
+  const started = Date.now();
+  fn().then(() => {
+    record(current, op, Date.now() - started);
+    record(totals, op, Date.now() - started);
+  }, (e) => {
+    const reason = classify(e);
+    record(current, op, Date.now() - started, reason);
+    record(totals, op, Date.now() - started, reason);
+  }).then(() => {
+    inFlight--;
+  });
+}
+
+let g;
+let makers = [];
+let takers = [];
+let stacker;
+
+function makerPlace () {
+  const maker = pick(makers);
+  const offset = 1 + Math.floor(Math.random() * SPREAD_CENTS);
+  if (Math.random() < 0.5) {
+    submit("limitbuygft", () => g.gftOrderBookContract.limitbuygft(maker.name, eos(MID_CENTS - offset), "0.10000000 GFT", { from: maker }));
+  } else {
+    submit("limitsellgft", () => g.gftOrderBookContract.limitsellgft(maker.name, eos(MID_CENTS + offset), "0.10000000 GFT", { from: maker }));
+  }
+}
+
+// Cancels the oldest order the maker still has on one side; the lookup is a read against
+// the API node and is not counted as a transaction.
+function makerCancel () {
+  const maker = pick(makers);
+  const buySide = Math.random() < 0.5;
+  const table = buySide ? "buyorders" : "sellorders";
+  submit(buySide ? "delbuyorder" : "delsellorder", async () => {
+    const rows = await chain.getRows(g, g.gftOrderBookAccount.name, g.gftOrderBookAccount.name, table, {
+      index_position: 2,
+      key_type: "name",
+      lower_bound: maker.name,
+      upper_bound: maker.name,
+      limit: 1
+    });
+    if (rows.length === 0) {
+      return;
+    }
+    return buySide
+      ? g.gftOrderBookContract.delbuyorder(rows[0].order_id, { from: maker })
+      : g.gftOrderBookContract.delsellorder(rows[0].order_id, { from: maker });
+  });
+}
+
+// marketsell is disabled in the contract, so selling takers cross with a low limit price
+function takerCross () {
+  const taker = pick(takers);
+  if (Math.random() < 0.5) {
+    submit("marketbuy", () => g.gftOrderBookContract.marketbuy(taker.name, "1.0000 EOS", { from: taker }));
+  } else {
+    submit("limitsellgft (cross)", () => g.gftOrderBookContract.limitsellgft(taker.name, eos(MID_CENTS - SPREAD_CENTS), "0.05000000 GFT", { from: taker }));
+  }
+}
+
+function nextOrder () {
+  const roll = Math.random();
+  if (roll < MAKER_PLACE) {
+    makerPlace();
+  } else if (roll < MAKER_PLACE + MAKER_CANCEL) {
+    makerCancel();
+  } else {
+    takerCross();
+  }
+}
+
+function upkeep () {
+  submit("stackbuy", () => g.gftOrderBookContract.stackbuy(stacker.name, "10.0000 EOS", { from: stacker }));
+  submit("stacksell", () => g.gftOrderBookContract.stacksell(stacker.name, "1.00000000 GFT", { from: stacker }));
+  submit("buildbuckets", () => g.gftOrderBookContract.buildbuckets({ from: g.gftOrderBookAccount }));
+  submit("payliqinfrew", () => g.gftOrderBookContract.payliqinfrew({ from: g.gftOrderBookAccount }));
+}
+
+async function bookDepth () {
+  try {
+    const rows = await chain.getRows(g, g.gftOrderBookAccount.name, g.gftOrderBookAccount.name, "states");
+    const s = rows[0];
+    return {
+      buy_orders: s.buy_order_count,
+      sell_orders: s.sell_order_count,
+      buy_gft: s.buy_orderbook_size_gft,
+      sell_gft: s.sell_orderbook_size_gft,
+      last_price: s.last_price
+    };
+  } catch (e) {
+    return { error: classify(e) };
+  }
+}
+
+function summarize (window, seconds) {
+  return {
+    sent: window.sent,
+    ok: window.ok,
+    failed: window.failed,
+    cpu_failed: window.cpu_failed,
+    dropped: window.dropped,
+    ok_per_sec: +(window.ok / seconds).toFixed(2),
+    cpu_failure_rate: window.sent > 0 ? +(window.cpu_failed / window.sent).toFixed(4) : 0,
+    latency_ms: {
+      p50: percentile(window.latencies, 0.5),
+      p90: percentile(window.latencies, 0.9),
+      p99: percentile(window.latencies, 0.99),
+      max: window.latencies.length > 0 ? Math.max(...window.latencies) : 0
+    },
+    reasons: window.reasons,
+    ops: window.ops
+  };
+}
+
+// Offers load at rate for seconds, sampling every SAMPLE_SEC into timeline.
+async function runStep (rate, seconds, started, timeline) {
+  const step = newWindow();
+  const deadline = Date.now() + seconds * 1000;
+  let nextSample = Date.now() + SAMPLE_SEC * 1000;
+  let nextUpkeep = Date.now() + UPKEEP_SEC * 1000;
+
+  while (Date.now() < deadline) {
+    // exponential gaps give Poisson arrivals at the offered rate
+    await sleep(-Math.log(1 - Math.random()) * 1000 / rate);
+    nextOrder();
+
+    if (Date.now() >= nextUpkeep) {
+      upkeep();
+      nextUpkeep += UPKEEP_SEC * 1000;
+    }
+
+    if (Date.now() >= nextSample) {
+      const window = current;
+      current = newWindow();
+      const sample = Object.assign({ t_sec: Math.round((Date.now() - started) / 1000), offered_rate: rate, in_flight: inFlight },
+        summarize(window, SAMPLE_SEC), { book: await bookDepth() });
+      delete sample.ops;
+      timeline.push(sample);
+      console.log("   t=" + String(sample.t_sec).padStart(4) + "s rate " + String(rate).padStart(5),
+        "ok/s", String(sample.ok_per_sec).padStart(6),
+        "p50/p90/p99", sample.latency_ms.p50 + "/" + sample.latency_ms.p90 + "/" + sample.latency_ms.p99, "ms",
+        "fail", sample.failed, "(cpu " + sample.cpu_failed + ")",
+        "book", sample.book.buy_orders + "/" + sample.book.sell_orders);
+
+      for (const key of ["sent", "ok", "failed", "cpu_failed", "dropped"]) {
+        step[key] += window[key];
+      }
+      nextSample += SAMPLE_SEC * 1000;
+    }
+  }
+  return step;
+}
+
+async function main () {
+  const nodeos = await chain.startNodeos(NODEOS);
+  try {
+    g = await chain.deployGyftie(eoslime);
+
+    console.log(" Seeding", MAKERS, "makers,", TAKERS, "takers and a stacker");
+    const traders = await chain.seedTraders(eoslime, g, MAKERS + TAKERS + 1);
+    makers = traders.slice(0, MAKERS);
+    takers = traders.slice(MAKERS, MAKERS + TAKERS);
+    stacker = traders[MAKERS + TAKERS];
+
+    // resting depth on both sides so the first takers have something to hit
+    for (const maker of makers) {
+      await g.gftOrderBookContract.limitbuygft(maker.name, eos(MID_CENTS - SPREAD_CENTS), "0.50000000 GFT", { from: maker });
+      await g.gftOrderBookContract.limitsellgft(maker.name, eos(MID_CENTS + SPREAD_CENTS), "0.50000000 GFT", { from: maker });
+    }
+    await g.gftOrderBookContract.addliqreward("10.00000000 GFT", { from: g.gftOrderBookAccount });
+
+    const started = Date.now();
+    const timeline = [];
+    const steps = [];
+    let sustained;
+
+    if (RAMP > 0) {
+      for (let rate = RATE; Date.now() - started < DURATION_SEC * 1000; rate += RAMP) {
+        console.log(" Offering", rate, "orders/sec");
+        const step = await runStep(rate, STEP_SEC, started, timeline);
+        const cpuRate = step.sent > 0 ? step.cpu_failed / step.sent : 0;
+        steps.push({ offered_rate: rate, sent: step.sent, ok: step.ok, failed: step.failed, cpu_failed: step.cpu_failed, dropped: step.dropped, cpu_failure_rate: +cpuRate.toFixed(4) });
+        if (cpuRate > MAX_CPU_FAILURES) {
+          break;
+        }
+        sustained = rate;
+      }
+    } else {
+      console.log(" Offering", RATE, "orders/sec for", DURATION_SEC, "seconds");
+      await runStep(RATE, DURATION_SEC, started, timeline);
+    }
+
+    // let in-flight transactions settle before the totals are read
+    while (inFlight > 0) {
+      await sleep(100);
+    }
+
+    const elapsed = (Date.now() - started) / 1000;
+    const report = {
+      config: { makers: MAKERS, takers: TAKERS, rate: RATE, ramp: RAMP, step_sec: STEP_SEC, duration_sec: DURATION_SEC, upkeep_sec: UPKEEP_SEC, max_inflight: MAX_INFLIGHT },
+      sustained_rate: RAMP > 0 ? (sustained === undefined ? null : sustained) : undefined,
+      totals: summarize(totals, elapsed),
+      steps: RAMP > 0 ? steps : undefined,
+      final_book: await bookDepth(),
+      timeline: timeline
+    };
+
+    fs.writeFileSync(REPORT, JSON.stringify(report, null, 2) + "\n");
+    console.log(" Totals", JSON.stringify(report.totals.latency_ms), "ok", report.totals.ok, "failed", report.totals.failed, "cpu", report.totals.cpu_failed);
+    if (RAMP > 0) {
+      console.log(" Sustained rate before CPU failures:", sustained === undefined ? "none" : sustained + " orders/sec");
+    }
+    console.log(" Wrote", REPORT);
+  } finally {
+    chain.stopNodeos(nodeos);
+  }
+}
+
+main().catch((e) => {
+  console.error(e);
+  process.exit(1);
+});